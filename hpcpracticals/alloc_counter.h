@@ -0,0 +1,52 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+// Counts every heap allocation the program makes by replacing the global
+// operator new/delete. The replacements are ordinary definitions, so include
+// this header from the program's main .cpp only.
+//   AllocSnapshot before = allocSnapshot();
+//   ... work ...
+//   AllocSnapshot used = allocSnapshot() - before;
+
+inline std::atomic<size_t>& allocCount() {
+    static std::atomic<size_t> count{0};
+    return count;
+}
+
+inline std::atomic<size_t>& allocBytes() {
+    static std::atomic<size_t> bytes{0};
+    return bytes;
+}
+
+struct AllocSnapshot {
+    size_t allocations;
+    size_t bytes;
+
+    AllocSnapshot operator-(const AllocSnapshot& earlier) const {
+        return {allocations - earlier.allocations, bytes - earlier.bytes};
+    }
+};
+
+inline AllocSnapshot allocSnapshot() {
+    return {allocCount().load(std::memory_order_relaxed), allocBytes().load(std::memory_order_relaxed)};
+}
+
+void* operator new(size_t size) {
+    allocCount().fetch_add(1, std::memory_order_relaxed);
+    allocBytes().fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+
+// Kept out of line: once inlined, GCC pairs the free() with the library's
+// operator new and reports a false -Wmismatched-new-delete
+__attribute__((noinline)) void operator delete(void* p) noexcept { std::free(p); }
+__attribute__((noinline)) void operator delete[](void* p) noexcept { std::free(p); }
+__attribute__((noinline)) void operator delete(void* p, size_t) noexcept { std::free(p); }
+__attribute__((noinline)) void operator delete[](void* p, size_t) noexcept { std::free(p); }
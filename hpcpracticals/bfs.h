@@ -0,0 +1,583 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include <omp.h>
+#include "csr_graph.h"
+#include "parallel_utils.h"
+
+// BFS engines that run on CSRGraph and report parent/level arrays
+// instead of printing vertices as they are visited.
+
+enum class BFSDirection { TopDown, BottomUp };
+
+inline const char* directionName(BFSDirection d) {
+    return d == BFSDirection::TopDown ? "top-down" : "bottom-up";
+}
+
+// Per-level record so callers can see where the time and edge checks go
+struct BFSLevelStats {
+    int level;                 // Depth of the frontier that was expanded
+    BFSDirection direction;    // Direction used to expand it
+    int64_t frontierVertices;  // Vertices in the frontier
+    int64_t edgesExamined;     // Adjacency entries read while expanding
+    double ms;                 // Wall time of the level
+};
+
+template <typename VertexT>
+struct BFSResult {
+    std::vector<VertexT> parent;   // -1 if unreached, the source is its own parent
+    std::vector<int32_t> level;    // -1 if unreached
+    std::vector<BFSLevelStats> levels;
+    int64_t reached = 0;
+};
+
+// Scratch space of frontierBFS. A caller that keeps one between runs pays for
+// the allocations once; reserve() does it up front.
+template <typename VertexT>
+struct BFSWorkspace {
+    Bitmap visited;
+    std::vector<VertexT> queue;
+    std::vector<std::vector<VertexT>> buffers; // One per thread
+    std::vector<size_t> offsets;
+
+    void reserve(VertexT n) {
+        visited.resize(n);
+        queue.reserve(n);
+        buffers.resize(omp_get_max_threads());
+        offsets.reserve(omp_get_max_threads() + 1);
+    }
+};
+
+// Lock-free level-synchronous BFS. All frontiers live back to back in one
+// flat queue array: level d occupies queue[head, tail) and threads read it by
+// index instead of popping a shared std::queue. Vertices are claimed with an
+// atomic test-and-set on a visited bitmap, so each one enters exactly one
+// thread's buffer; the buffers are then copied to the end of the queue at
+// offsets given by a prefix sum over the per-thread counts. When order is
+// non-null it receives the whole queue, which is a valid BFS visit order.
+// This overload fills a caller-owned result with caller-owned scratch space;
+// arrays that already have capacity for n vertices are reused instead of
+// reallocated, so repeated runs on one graph do not allocate.
+template <typename Graph>
+void frontierBFS(const Graph& g, typename Graph::vertex_type source, BFSResult<typename Graph::vertex_type>& result,
+                 BFSWorkspace<typename Graph::vertex_type>& work,
+                 std::vector<typename Graph::vertex_type>* order = nullptr) {
+    using V = typename Graph::vertex_type;
+    const V n = g.numVertices();
+
+    result.parent.assign(n, -1);
+    result.level.assign(n, -1);
+    result.levels.clear();
+    result.parent[source] = source;
+    result.level[source] = 0;
+
+    const int maxThreads = omp_get_max_threads();
+    work.reserve(n);
+    Bitmap& visited = work.visited;
+    std::vector<V>& queue = work.queue;
+    std::vector<std::vector<V>>& buffers = work.buffers;
+    std::vector<size_t>& offsets = work.offsets;
+    visited.set(source);
+    queue.resize(n);
+    offsets.assign(maxThreads + 1, 0);
+    queue[0] = source;
+    size_t head = 0, tail = 1;
+    int depth = 0;
+
+    while (head < tail) {
+        double t0 = omp_get_wtime();
+        int64_t examined = 0;
+        int usedThreads = 1;
+
+        #pragma omp parallel reduction(+:examined)
+        {
+            const int tid = omp_get_thread_num();
+            std::vector<V>& local = buffers[tid];
+            local.clear();
+
+            #pragma omp for schedule(dynamic, 64) nowait
+            for (size_t i = head; i < tail; i++) {
+                V u = queue[i];
+                for (V w : g.neighbors(u)) {
+                    examined++;
+                    if (!visited.test(w) && !visited.testAndSet(w)) {
+                        result.parent[w] = u;
+                        result.level[w] = depth + 1;
+                        local.push_back(w);
+                    }
+                }
+            }
+            offsets[tid + 1] = local.size();
+
+            #pragma omp barrier
+            #pragma omp single
+            {
+                usedThreads = omp_get_num_threads();
+                for (int t = 0; t < usedThreads; t++) offsets[t + 1] += offsets[t];
+            }
+            std::copy(local.begin(), local.end(), queue.begin() + tail + offsets[tid]);
+        }
+
+        result.levels.push_back({depth, BFSDirection::TopDown, (int64_t)(tail - head), examined,
+                                 (omp_get_wtime() - t0) * 1000.0});
+        head = tail;
+        tail += offsets[usedThreads];
+        depth++;
+    }
+
+    result.reached = tail;
+    if (order) order->assign(queue.begin(), queue.begin() + tail);
+}
+
+template <typename Graph>
+void frontierBFS(const Graph& g, typename Graph::vertex_type source, BFSResult<typename Graph::vertex_type>& result,
+                 std::vector<typename Graph::vertex_type>* order = nullptr) {
+    BFSWorkspace<typename Graph::vertex_type> work;
+    frontierBFS(g, source, result, work, order);
+}
+
+template <typename Graph>
+BFSResult<typename Graph::vertex_type> frontierBFS(const Graph& g, typename Graph::vertex_type source,
+                                                   std::vector<typename Graph::vertex_type>* order = nullptr) {
+    BFSResult<typename Graph::vertex_type> result;
+    frontierBFS(g, source, result, order);
+    return result;
+}
+
+// Parallel BFS whose visit order, parents and levels equal the sequential
+// queue BFS on every run and thread count. Sequentially, a vertex is appended
+// by the earliest frontier vertex that lists it, in that vertex's adjacency
+// order. Each level reproduces this in three parallel passes over the frontier
+// with no serial merge:
+//   1. every unvisited neighbour gets the smallest queue position of a frontier
+//      vertex listing it (atomic min), so the earliest parent wins;
+//   2. each frontier vertex counts the neighbours it won, first occurrences only;
+//   3. a prefix sum over the counts gives each frontier vertex its output slot,
+//      and it writes its winners there in adjacency order.
+// Frontiers of up to 256 vertices run the same passes on one thread, which
+// keeps long thin graphs from paying for three parallel regions per level.
+template <typename Graph>
+BFSResult<typename Graph::vertex_type> deterministicBFS(const Graph& g, typename Graph::vertex_type source,
+                                                        std::vector<typename Graph::vertex_type>* order = nullptr) {
+    using V = typename Graph::vertex_type;
+    const V n = g.numVertices();
+
+    BFSResult<V> result;
+    result.parent.assign(n, -1);
+    result.level.assign(n, -1);
+    result.parent[source] = source;
+    result.level[source] = 0;
+
+    std::vector<V> queue(n);
+    std::vector<V> claim(n, n); // Queue position of the winning parent; n = unclaimed
+    std::vector<int64_t> counts(static_cast<size_t>(n) + 1);
+    queue[0] = source;
+    size_t head = 0, tail = 1;
+    int depth = 0;
+
+    while (head < tail) {
+        double t0 = omp_get_wtime();
+        const int64_t frontier = tail - head;
+        const bool wide = frontier > 256;
+        int64_t examined = 0;
+
+        #pragma omp parallel for schedule(dynamic, 64) reduction(+:examined) if(wide)
+        for (int64_t i = 0; i < frontier; i++) {
+            const V position = (V)(head + i);
+            for (V w : g.neighbors(queue[position])) {
+                examined++;
+                if (result.level[w] < 0 && atomicLoad(claim[w]) > position) atomicMin(claim[w], position);
+            }
+        }
+
+        #pragma omp parallel for schedule(dynamic, 64) if(wide)
+        for (int64_t i = 0; i < frontier; i++) {
+            const V position = (V)(head + i);
+            int64_t won = 0;
+            for (V w : g.neighbors(queue[position])) {
+                if (claim[w] == position && result.level[w] < 0) {
+                    result.level[w] = depth + 1;
+                    won++;
+                }
+            }
+            counts[i] = won;
+        }
+        int64_t next = 0;
+        if (wide) {
+            next = parallelExclusiveScan(counts.data(), (size_t)frontier);
+        } else {
+            for (int64_t i = 0; i < frontier; i++) {
+                int64_t c = counts[i];
+                counts[i] = next;
+                next += c;
+            }
+        }
+
+        #pragma omp parallel for schedule(dynamic, 64) if(wide)
+        for (int64_t i = 0; i < frontier; i++) {
+            const V position = (V)(head + i);
+            const V u = queue[position];
+            size_t out = tail + counts[i];
+            for (V w : g.neighbors(u)) {
+                if (claim[w] == position && result.parent[w] < 0) {
+                    result.parent[w] = u;
+                    queue[out++] = w;
+                }
+            }
+        }
+
+        result.levels.push_back({depth, BFSDirection::TopDown, frontier, examined, (omp_get_wtime() - t0) * 1000.0});
+        head = tail;
+        tail += next;
+        depth++;
+    }
+
+    result.reached = tail;
+    if (order) order->assign(queue.begin(), queue.begin() + tail);
+    return result;
+}
+
+// Direction-optimizing BFS tuning (Beamer et al.)
+struct HybridBFSOptions {
+    double alpha = 15.0; // Go bottom-up once frontier arcs exceed unexplored arcs / alpha
+    double beta = 18.0;  // Go back top-down once the frontier shrinks below n / beta vertices
+};
+
+// Hybrid BFS: each level is expanded either top-down (frontier vertices push to
+// unvisited neighbours) or bottom-up (unvisited vertices look for any parent in
+// the frontier and stop at the first hit). Bottom-up skips most edge checks on
+// the huge middle levels of low-diameter graphs. The graph must be undirected
+// (every arc stored in both directions) for the bottom-up step to be valid.
+template <typename Graph>
+BFSResult<typename Graph::vertex_type> hybridBFS(const Graph& g, typename Graph::vertex_type source,
+                                                 const HybridBFSOptions& options = HybridBFSOptions()) {
+    using V = typename Graph::vertex_type;
+    const V n = g.numVertices();
+
+    BFSResult<V> result;
+    result.parent.assign(n, -1);
+    result.level.assign(n, -1);
+    result.parent[source] = source;
+    result.level[source] = 0;
+
+    std::vector<V> frontier(1, source);
+    Bitmap frontierBits(n);
+    int64_t frontierArcs = g.degree(source);
+    int64_t unexploredArcs = (int64_t)g.numArcs() - frontierArcs;
+    int64_t previousFrontier = 0;
+    BFSDirection direction = BFSDirection::TopDown;
+    int depth = 0;
+    result.reached = 1;
+
+    while (!frontier.empty()) {
+        const int64_t frontierSize = frontier.size();
+        if (direction == BFSDirection::TopDown) {
+            if (frontierArcs > unexploredArcs / options.alpha && frontierSize > previousFrontier) {
+                direction = BFSDirection::BottomUp;
+            }
+        } else if (frontierSize < n / options.beta && frontierSize < previousFrontier) {
+            direction = BFSDirection::TopDown;
+        }
+
+        double t0 = omp_get_wtime();
+        std::vector<V> next;
+        int64_t examined = 0, nextArcs = 0;
+
+        if (direction == BFSDirection::TopDown) {
+            #pragma omp parallel reduction(+:examined, nextArcs)
+            {
+                std::vector<V> local;
+                #pragma omp for schedule(dynamic, 64) nowait
+                for (int64_t i = 0; i < frontierSize; i++) {
+                    V u = frontier[i];
+                    for (V w : g.neighbors(u)) {
+                        examined++;
+                        if (atomicLoad(result.parent[w]) < 0 && compareAndSwap(result.parent[w], V(-1), u)) {
+                            result.level[w] = depth + 1;
+                            nextArcs += g.degree(w);
+                            local.push_back(w);
+                        }
+                    }
+                }
+                #pragma omp critical
+                next.insert(next.end(), local.begin(), local.end());
+            }
+        } else {
+            frontierBits.clear();
+            #pragma omp parallel for schedule(static)
+            for (int64_t i = 0; i < frontierSize; i++) frontierBits.setAtomic(frontier[i]);
+
+            #pragma omp parallel reduction(+:examined, nextArcs)
+            {
+                std::vector<V> local;
+                // Each unvisited vertex is owned by one thread, so no atomics are needed
+                #pragma omp for schedule(dynamic, 1024) nowait
+                for (int64_t v = 0; v < (int64_t)n; v++) {
+                    if (result.parent[v] >= 0) continue;
+                    for (V u : g.neighbors((V)v)) {
+                        examined++;
+                        if (frontierBits.test(u)) {
+                            result.parent[v] = u;
+                            result.level[v] = depth + 1;
+                            nextArcs += g.degree((V)v);
+                            local.push_back((V)v);
+                            break;
+                        }
+                    }
+                }
+                #pragma omp critical
+                next.insert(next.end(), local.begin(), local.end());
+            }
+        }
+
+        result.levels.push_back({depth, direction, frontierSize, examined, (omp_get_wtime() - t0) * 1000.0});
+        result.reached += next.size();
+        unexploredArcs -= nextArcs;
+        frontierArcs = nextArcs;
+        previousFrontier = frontierSize;
+        frontier.swap(next);
+        depth++;
+    }
+    return result;
+}
+
+// Graph500-style check of a BFS tree: the source is level 0, every reached
+// vertex hangs off a neighbour one level up, and no edge spans more than one
+// level or joins a reached vertex to an unreached one.
+template <typename Graph>
+bool validateBFSTree(const Graph& g, typename Graph::vertex_type source,
+                     const BFSResult<typename Graph::vertex_type>& result) {
+    using V = typename Graph::vertex_type;
+    const V n = g.numVertices();
+    if (result.level[source] != 0 || result.parent[source] != source) return false;
+
+    bool ok = true;
+    #pragma omp parallel for schedule(dynamic, 1024) reduction(&&:ok)
+    for (int64_t v = 0; v < (int64_t)n; v++) {
+        int32_t lv = result.level[v];
+        if (lv > 0) {
+            V p = result.parent[v];
+            bool parentIsNeighbour = false;
+            if (p >= 0 && p < n && result.level[p] == lv - 1) {
+                for (V w : g.neighbors((V)v)) {
+                    if (w == p) { parentIsNeighbour = true; break; }
+                }
+            }
+            ok = ok && parentIsNeighbour;
+        } else if (lv < 0) {
+            ok = ok && result.parent[v] < 0;
+        }
+        for (V w : g.neighbors((V)v)) {
+            int32_t lw = result.level[w];
+            if ((lv < 0) != (lw < 0) || (lv >= 0 && (lv - lw > 1 || lw - lv > 1))) ok = false;
+        }
+    }
+    return ok;
+}
+
+// Multi-source BFS tuning
+struct MultiSourceBFSOptions {
+    int batchSize = 512;          // Sources per pass: a multiple of 64, at most 512
+    bool computeDistances = true; // false keeps only the reachability masks
+};
+
+template <typename VertexT>
+struct MultiSourceBFSResult {
+    VertexT numVertices = 0;
+    std::vector<VertexT> sources;
+    size_t words = 0;              // 64-bit words per vertex in `reached`
+    std::vector<uint64_t> reached; // Bit i of vertex v's mask is set if sources[i] reaches v
+    std::vector<int32_t> distance; // Vertex-major: distance[v * sources.size() + i], -1 if unreached
+    int64_t edgesExamined = 0;
+
+    bool reaches(size_t i, VertexT v) const { return (reached[(size_t)v * words + i / 64] >> (i % 64)) & 1; }
+    int32_t dist(size_t i, VertexT v) const { return distance[(size_t)v * sources.size() + i]; }
+};
+
+namespace bfs_detail {
+
+// One MS-BFS pass (Then et al., VLDB'14) over up to 64 * W sources. Every
+// vertex carries W-word masks: `seen` (sources that reached it), `visit`
+// (sources whose frontier contains it) and `next`. One adjacency scan moves
+// all sources at once, so the graph is read once per level for the whole batch.
+// Small frontiers push masks to neighbours with atomic OR; large ones switch to
+// a pull pass where each vertex ORs its neighbours' masks and stops as soon as
+// every source it still lacks has been found.
+template <int W, typename Graph>
+void multiSourceBatch(const Graph& g, const typename Graph::vertex_type* sources, int count,
+                      MultiSourceBFSResult<typename Graph::vertex_type>& out, size_t firstSource) {
+    using V = typename Graph::vertex_type;
+    const V n = g.numVertices();
+    const size_t stride = out.sources.size();
+    const bool withDistances = !out.distance.empty();
+
+    uint64_t valid[W];
+    for (int k = 0; k < W; k++) {
+        int bits = count - 64 * k;
+        valid[k] = bits >= 64 ? ~uint64_t(0) : bits <= 0 ? 0 : (uint64_t(1) << bits) - 1;
+    }
+
+    std::vector<uint64_t> seen((size_t)n * W, 0), visit((size_t)n * W, 0), next((size_t)n * W, 0);
+    Bitmap touched(n);
+    std::vector<V> frontier;
+    for (int i = 0; i < count; i++) {
+        V s = sources[i];
+        uint64_t bit = uint64_t(1) << (i % 64);
+        bool first = true;
+        for (int k = 0; k < W; k++) first = first && visit[(size_t)s * W + k] == 0;
+        if (first) frontier.push_back(s);
+        seen[(size_t)s * W + i / 64] |= bit;
+        visit[(size_t)s * W + i / 64] |= bit;
+        if (withDistances) out.distance[(size_t)s * stride + firstSource + i] = 0;
+    }
+
+    int32_t depth = 0;
+    int64_t examined = 0;
+    while (!frontier.empty()) {
+        const int64_t frontierSize = frontier.size();
+        int64_t frontierArcs = 0;
+        #pragma omp parallel for schedule(static) reduction(+:frontierArcs)
+        for (int64_t i = 0; i < frontierSize; i++) frontierArcs += g.degree(frontier[i]);
+        const bool pull = frontierArcs * 15 > (int64_t)g.numArcs();
+
+        std::vector<V> candidates;
+        if (!pull) {
+            #pragma omp parallel reduction(+:examined)
+            {
+                std::vector<V> local;
+                #pragma omp for schedule(dynamic, 64) nowait
+                for (int64_t i = 0; i < frontierSize; i++) {
+                    const uint64_t* mask = &visit[(size_t)frontier[i] * W];
+                    for (V w : g.neighbors(frontier[i])) {
+                        examined++;
+                        bool any = false;
+                        for (int k = 0; k < W; k++) {
+                            uint64_t fresh = mask[k] & ~seen[(size_t)w * W + k];
+                            if (fresh) {
+                                __atomic_fetch_or(&next[(size_t)w * W + k], fresh, __ATOMIC_RELAXED);
+                                any = true;
+                            }
+                        }
+                        if (any && !touched.test(w) && !touched.testAndSet(w)) local.push_back(w);
+                    }
+                }
+                #pragma omp critical
+                candidates.insert(candidates.end(), local.begin(), local.end());
+            }
+        } else {
+            #pragma omp parallel reduction(+:examined)
+            {
+                std::vector<V> local;
+                #pragma omp for schedule(dynamic, 1024) nowait
+                for (int64_t w = 0; w < (int64_t)n; w++) {
+                    uint64_t wanted[W], acc[W];
+                    bool needed = false;
+                    for (int k = 0; k < W; k++) {
+                        wanted[k] = valid[k] & ~seen[(size_t)w * W + k];
+                        acc[k] = 0;
+                        needed = needed || wanted[k];
+                    }
+                    if (!needed) continue;
+                    for (V u : g.neighbors((V)w)) {
+                        examined++;
+                        bool complete = true;
+                        for (int k = 0; k < W; k++) {
+                            acc[k] |= visit[(size_t)u * W + k];
+                            complete = complete && (acc[k] & wanted[k]) == wanted[k];
+                        }
+                        if (complete) break;
+                    }
+                    bool any = false;
+                    for (int k = 0; k < W; k++) {
+                        next[(size_t)w * W + k] = acc[k] & wanted[k];
+                        any = any || next[(size_t)w * W + k];
+                    }
+                    if (any) local.push_back((V)w);
+                }
+                #pragma omp critical
+                candidates.insert(candidates.end(), local.begin(), local.end());
+            }
+        }
+
+        // The old frontier's masks are no longer needed once every neighbour has read them
+        #pragma omp parallel for schedule(static)
+        for (int64_t i = 0; i < frontierSize; i++) {
+            for (int k = 0; k < W; k++) visit[(size_t)frontier[i] * W + k] = 0;
+        }
+
+        const int64_t candidateCount = candidates.size();
+        std::vector<char> advanced(candidateCount, 0);
+        #pragma omp parallel for schedule(dynamic, 256)
+        for (int64_t i = 0; i < candidateCount; i++) {
+            V w = candidates[i];
+            bool any = false;
+            for (int k = 0; k < W; k++) {
+                uint64_t fresh = next[(size_t)w * W + k] & ~seen[(size_t)w * W + k];
+                next[(size_t)w * W + k] = 0;
+                seen[(size_t)w * W + k] |= fresh;
+                visit[(size_t)w * W + k] = fresh;
+                any = any || fresh;
+                if (withDistances) {
+                    int32_t* row = &out.distance[(size_t)w * stride + firstSource + 64 * k];
+                    for (; fresh; fresh &= fresh - 1) row[__builtin_ctzll(fresh)] = depth + 1;
+                }
+            }
+            advanced[i] = any;
+        }
+        if (!pull) touched.clear();
+
+        frontier.clear();
+        for (int64_t i = 0; i < candidateCount; i++) {
+            if (advanced[i]) frontier.push_back(candidates[i]);
+        }
+        depth++;
+    }
+
+    const size_t firstWord = firstSource / 64;
+    #pragma omp parallel for schedule(static)
+    for (int64_t v = 0; v < (int64_t)n; v++) {
+        for (int k = 0; k < W; k++) out.reached[(size_t)v * out.words + firstWord + k] = seen[(size_t)v * W + k];
+    }
+    __atomic_fetch_add(&out.edgesExamined, examined, __ATOMIC_RELAXED);
+}
+
+} // namespace bfs_detail
+
+// Batched multi-source BFS: answers many single-source queries on the same
+// graph in passes of up to 512 sources. The adjacency traffic of a pass is
+// shared by all of its sources instead of being paid once per query.
+template <typename Graph>
+MultiSourceBFSResult<typename Graph::vertex_type> multiSourceBFS(
+        const Graph& g, const std::vector<typename Graph::vertex_type>& sources,
+        const MultiSourceBFSOptions& options = MultiSourceBFSOptions()) {
+    using V = typename Graph::vertex_type;
+    const V n = g.numVertices();
+    int batch = options.batchSize - options.batchSize % 64;
+    if (batch < 64) batch = 64;
+    if (batch > 512) batch = 512;
+
+    MultiSourceBFSResult<V> result;
+    result.numVertices = n;
+    result.sources = sources;
+    result.words = (sources.size() + 63) / 64;
+    result.reached.assign((size_t)n * result.words, 0);
+    if (options.computeDistances) result.distance.assign((size_t)n * sources.size(), -1);
+
+    for (size_t first = 0; first < sources.size(); first += batch) {
+        int count = (int)std::min<size_t>(batch, sources.size() - first);
+        const V* batchSources = sources.data() + first;
+        switch ((count + 63) / 64) {
+            case 1: bfs_detail::multiSourceBatch<1>(g, batchSources, count, result, first); break;
+            case 2: bfs_detail::multiSourceBatch<2>(g, batchSources, count, result, first); break;
+            case 3: bfs_detail::multiSourceBatch<3>(g, batchSources, count, result, first); break;
+            case 4: bfs_detail::multiSourceBatch<4>(g, batchSources, count, result, first); break;
+            case 5: bfs_detail::multiSourceBatch<5>(g, batchSources, count, result, first); break;
+            case 6: bfs_detail::multiSourceBatch<6>(g, batchSources, count, result, first); break;
+            case 7: bfs_detail::multiSourceBatch<7>(g, batchSources, count, result, first); break;
+            default: bfs_detail::multiSourceBatch<8>(g, batchSources, count, result, first); break;
+        }
+    }
+    return result;
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include <omp.h>
+#include "csr_graph.h"
+#include "parallel_utils.h"
+
+// Connected components on CSRGraph (undirected: every edge stored both ways)
+
+template <typename VertexT>
+struct ComponentsResult {
+    std::vector<VertexT> component; // Dense component id (0 .. count-1) per vertex
+    std::vector<int64_t> sizes;     // Vertices per component id
+    VertexT largest = -1;           // Id of the largest component
+};
+
+namespace components_detail {
+
+// Hooks the trees of u and v together, always pointing the higher root at the
+// lower one so no cycle can form; retries when another thread moved a root first
+template <typename VertexT>
+void link(VertexT u, VertexT v, std::vector<VertexT>& comp) {
+    VertexT p1 = atomicLoad(comp[u]);
+    VertexT p2 = atomicLoad(comp[v]);
+    while (p1 != p2) {
+        VertexT high = std::max(p1, p2);
+        VertexT low = std::min(p1, p2);
+        VertexT pHigh = atomicLoad(comp[high]);
+        if (pHigh == low) break;
+        if (pHigh == high && compareAndSwap(comp[high], high, low)) break;
+        p1 = atomicLoad(comp[atomicLoad(comp[high])]);
+        p2 = atomicLoad(comp[low]);
+    }
+}
+
+// Pointer jumping until every vertex points straight at its root
+template <typename VertexT>
+void compress(std::vector<VertexT>& comp) {
+    #pragma omp parallel for schedule(dynamic, 16384)
+    for (int64_t v = 0; v < (int64_t)comp.size(); v++) {
+        while (comp[v] != comp[comp[v]]) comp[v] = comp[comp[v]];
+    }
+}
+
+// Most common label among a random sample: almost always the giant component
+template <typename VertexT>
+VertexT sampleFrequentLabel(const std::vector<VertexT>& comp, int samples = 1024) {
+    std::unordered_map<VertexT, int> counts;
+    std::mt19937 rng(27491095);
+    std::uniform_int_distribution<int64_t> pick(0, (int64_t)comp.size() - 1);
+    VertexT best = comp[0];
+    int bestCount = 0;
+    for (int i = 0; i < samples; i++) {
+        VertexT label = comp[pick(rng)];
+        int c = ++counts[label];
+        if (c > bestCount) {
+            best = label;
+            bestCount = c;
+        }
+    }
+    return best;
+}
+
+} // namespace components_detail
+
+// Afforest (Sutton et al., IPDPS'18): union-find with lock-free CAS hooking.
+// It first links every vertex along only its first `neighborRounds` edges and
+// compresses, which already merges nearly all of a giant component. It then
+// samples the most frequent label and skips all remaining edges of vertices in
+// that component; only the other vertices finish their lists. Most edges of
+// real graphs are never touched, and there is no per-level synchronisation as
+// in repeated BFS.
+template <typename Graph>
+ComponentsResult<typename Graph::vertex_type> afforestComponents(const Graph& g, int neighborRounds = 2) {
+    using namespace components_detail;
+    using V = typename Graph::vertex_type;
+    const V n = g.numVertices();
+    ComponentsResult<V> result;
+    if (n == 0) return result;
+
+    std::vector<V> comp(n);
+    #pragma omp parallel for schedule(static)
+    for (int64_t v = 0; v < (int64_t)n; v++) comp[v] = (V)v;
+
+    for (int r = 0; r < neighborRounds; r++) {
+        #pragma omp parallel for schedule(dynamic, 16384)
+        for (int64_t u = 0; u < (int64_t)n; u++) {
+            auto nbrs = g.neighbors((V)u);
+            if ((int64_t)nbrs.size() > r) link((V)u, nbrs.begin()[r], comp);
+        }
+        compress(comp);
+    }
+
+    const V giant = sampleFrequentLabel(comp);
+    #pragma omp parallel for schedule(dynamic, 16384)
+    for (int64_t u = 0; u < (int64_t)n; u++) {
+        if (comp[u] == giant) continue;
+        auto nbrs = g.neighbors((V)u);
+        for (int64_t i = neighborRounds; i < (int64_t)nbrs.size(); i++) link((V)u, nbrs.begin()[i], comp);
+    }
+    compress(comp);
+
+    // Roots get dense ids in vertex order via a prefix sum
+    std::vector<V> rootId(n);
+    #pragma omp parallel for schedule(static)
+    for (int64_t v = 0; v < (int64_t)n; v++) rootId[v] = comp[v] == v ? 1 : 0;
+    const V count = parallelExclusiveScan(rootId.data(), (size_t)n);
+
+    // Only vertices outside the sampled component are counted atomically, so
+    // threads do not all contend on one counter; its size is what remains
+    const V giantId = rootId[comp[giant]];
+    result.component.resize(n);
+    result.sizes.assign(count, 0);
+    int64_t others = 0;
+    #pragma omp parallel for schedule(static) reduction(+:others)
+    for (int64_t v = 0; v < (int64_t)n; v++) {
+        V id = rootId[comp[v]];
+        result.component[v] = id;
+        if (id == giantId) continue;
+        __atomic_fetch_add(&result.sizes[id], 1, __ATOMIC_RELAXED);
+        others++;
+    }
+    result.sizes[giantId] = n - others;
+
+    result.largest = 0;
+    for (V c = 1; c < count; c++) {
+        if (result.sizes[c] > result.sizes[result.largest]) result.largest = c;
+    }
+    return result;
+}
+
+// Checks a labelling: both ends of every edge share a label, and there are
+// exactly `expectedCount` labels (so no component was split)
+template <typename Graph>
+bool validateComponents(const Graph& g, const ComponentsResult<typename Graph::vertex_type>& result,
+                        int64_t expectedCount) {
+    using V = typename Graph::vertex_type;
+    const V n = g.numVertices();
+    if ((int64_t)result.sizes.size() != expectedCount) return false;
+    bool ok = true;
+    #pragma omp parallel for schedule(dynamic, 4096) reduction(&&:ok)
+    for (int64_t u = 0; u < (int64_t)n; u++) {
+        for (V w : g.neighbors((V)u)) ok = ok && result.component[u] == result.component[w];
+    }
+    return ok;
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <omp.h>
+#include "csr_graph.h"
+#include "parallel_utils.h"
+
+// Read-only graph with byte-compressed neighbour lists, a drop-in for
+// CSRGraph in the BFS engines (they only iterate g.neighbors(v) forwards).
+// Each list is stored sorted as LEB128 varints: the degree, then the first
+// neighbour as a zigzag-coded difference from v, then the gaps between
+// consecutive neighbours. Gaps are small once lists are sorted (and smaller
+// still after a locality reordering), so most arcs take one or two bytes
+// instead of sizeof(VertexT); the per-vertex cost is one 64-bit byte offset.
+template <typename VertexT = int32_t>
+class CompressedGraph {
+public:
+    using vertex_type = VertexT;
+    using offset_type = int64_t;
+
+    // Decodes one list on the fly; only forward iteration is possible
+    class NeighborIterator {
+    public:
+        NeighborIterator(const uint8_t* p, VertexT v, int64_t count) : pos(p), remaining(count) {
+            if (remaining > 0) value = (VertexT)((int64_t)v + unzigzag(readVarint(pos)));
+        }
+        VertexT operator*() const { return value; }
+        NeighborIterator& operator++() {
+            if (--remaining > 0) value = (VertexT)(value + (VertexT)readVarint(pos));
+            return *this;
+        }
+        bool operator!=(const NeighborIterator& other) const { return remaining != other.remaining; }
+
+    private:
+        const uint8_t* pos;
+        int64_t remaining;
+        VertexT value = 0;
+    };
+
+    struct NeighborRange {
+        const uint8_t* data; // First byte after the degree
+        VertexT vertex;
+        int64_t count;
+        NeighborIterator begin() const { return NeighborIterator(data, vertex, count); }
+        NeighborIterator end() const { return NeighborIterator(nullptr, vertex, 0); }
+        size_t size() const { return static_cast<size_t>(count); }
+    };
+
+    CompressedGraph() : offsets_(1, 0) {}
+
+    // Encodes a CSR graph in parallel: one pass sizes every list, a prefix
+    // sum places them, a second pass writes them. Unsorted lists are sorted
+    // into a per-thread buffer first.
+    template <typename OffsetT>
+    static CompressedGraph fromCSR(const CSRGraph<VertexT, OffsetT>& g) {
+        const VertexT n = g.numVertices();
+        CompressedGraph result;
+        result.numArcs_ = g.numArcs();
+        result.offsets_.assign(static_cast<size_t>(n) + 1, 0);
+
+        const int maxThreads = omp_get_max_threads();
+        std::vector<std::vector<VertexT>> scratch(maxThreads);
+        auto sortedList = [&](VertexT v) -> std::pair<const VertexT*, const VertexT*> {
+            auto nbrs = g.neighbors(v);
+            if (std::is_sorted(nbrs.begin(), nbrs.end())) return {nbrs.begin(), nbrs.end()};
+            std::vector<VertexT>& buf = scratch[omp_get_thread_num()];
+            buf.assign(nbrs.begin(), nbrs.end());
+            std::sort(buf.begin(), buf.end());
+            return {buf.data(), buf.data() + buf.size()};
+        };
+
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for (int64_t v = 0; v < (int64_t)n; v++) {
+            auto list = sortedList((VertexT)v);
+            result.offsets_[v] = encode((VertexT)v, list.first, list.second, nullptr);
+        }
+        result.offsets_[n] = parallelExclusiveScan(result.offsets_.data(), (size_t)n);
+
+        result.bytes_.resize(static_cast<size_t>(result.offsets_[n]));
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for (int64_t v = 0; v < (int64_t)n; v++) {
+            auto list = sortedList((VertexT)v);
+            encode((VertexT)v, list.first, list.second, result.bytes_.data() + result.offsets_[v]);
+        }
+        return result;
+    }
+
+    VertexT numVertices() const { return static_cast<VertexT>(offsets_.size() - 1); }
+
+    int64_t numArcs() const { return numArcs_; }
+
+    int64_t degree(VertexT v) const {
+        const uint8_t* p = bytes_.data() + offsets_[v];
+        return (int64_t)readVarint(p);
+    }
+
+    NeighborRange neighbors(VertexT v) const {
+        const uint8_t* p = bytes_.data() + offsets_[v];
+        int64_t count = (int64_t)readVarint(p);
+        return {p, v, count};
+    }
+
+    size_t memoryBytes() const { return offsets_.size() * sizeof(int64_t) + bytes_.size(); }
+
+private:
+    static uint64_t zigzag(int64_t x) { return ((uint64_t)x << 1) ^ (uint64_t)(x >> 63); }
+    static int64_t unzigzag(uint64_t x) { return (int64_t)(x >> 1) ^ -(int64_t)(x & 1); }
+
+    static uint64_t readVarint(const uint8_t*& p) {
+        uint64_t x = *p++;
+        if (x < 0x80) return x; // One-byte fast path: most gaps
+        x &= 0x7f;
+        for (int shift = 7;; shift += 7) {
+            uint64_t b = *p++;
+            x |= (b & 0x7f) << shift;
+            if (b < 0x80) return x;
+        }
+    }
+
+    // Writes x at out (if non-null) and returns its encoded length
+    static int64_t writeVarint(uint64_t x, uint8_t* out) {
+        int64_t len = 1;
+        while (x >= 0x80) {
+            if (out) *out++ = (uint8_t)(x | 0x80);
+            x >>= 7;
+            len++;
+        }
+        if (out) *out = (uint8_t)x;
+        return len;
+    }
+
+    // Encodes one sorted list; with out == nullptr only measures it
+    static int64_t encode(VertexT v, const VertexT* first, const VertexT* last, uint8_t* out) {
+        int64_t len = writeVarint((uint64_t)(last - first), out);
+        VertexT prev = v;
+        for (const VertexT* it = first; it != last; ++it) {
+            uint64_t code = it == first ? zigzag((int64_t)*it - (int64_t)v) : (uint64_t)(*it - prev);
+            len += writeVarint(code, out ? out + len : nullptr);
+            prev = *it;
+        }
+        return len;
+    }
+
+    std::vector<int64_t> offsets_; // Byte offset of each vertex's list
+    std::vector<uint8_t> bytes_;
+    int64_t numArcs_ = 0;
+};
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <omp.h>
+#include "parallel_utils.h"
+
+// Options for CSRGraph::fromEdgesParallel
+struct CSRBuildOptions {
+    bool undirected = true;        // Store every edge in both directions
+    bool sortNeighbors = false;    // Sort each list so neighbour order does not depend on thread timing
+    bool removeSelfLoops = false;  // Drop (v, v) edges
+    bool removeDuplicates = false; // Keep one copy of parallel edges (implies sorted lists)
+};
+
+// Immutable graph in compressed sparse row (CSR) form.
+// The neighbours of vertex v are adjacency[offsets[v] .. offsets[v + 1]),
+// so every traversal walks two flat arrays instead of one heap block per vertex.
+// Vertex ids are 0-based; VertexT selects 32- or 64-bit ids and OffsetT must be
+// wide enough to index every stored arc (an undirected edge is stored twice).
+template <typename VertexT = int32_t, typename OffsetT = int64_t>
+class CSRGraph {
+public:
+    using vertex_type = VertexT;
+    using offset_type = OffsetT;
+    using Edge = std::pair<VertexT, VertexT>;
+
+    // Lightweight view so callers can write `for (auto w : g.neighbors(v))`
+    struct NeighborRange {
+        const VertexT* first;
+        const VertexT* last;
+        const VertexT* begin() const { return first; }
+        const VertexT* end() const { return last; }
+        size_t size() const { return static_cast<size_t>(last - first); }
+    };
+
+    CSRGraph() : offsets_(1, 0) {}
+
+    CSRGraph(std::vector<OffsetT> offsets, std::vector<VertexT> adjacency)
+        : offsets_(std::move(offsets)), adjacency_(std::move(adjacency)) {
+        if (offsets_.empty() || offsets_.front() != 0 ||
+            offsets_.back() != static_cast<OffsetT>(adjacency_.size())) {
+            throw std::invalid_argument("CSRGraph: offsets do not describe the adjacency array");
+        }
+    }
+
+    // Build from an edge list with a counting pass, a prefix sum and a scatter.
+    // Neighbour order follows edge order, so traversals visit vertices in the
+    // same order an adjacency list filled with push_back would.
+    static CSRGraph fromEdges(VertexT numVertices, const std::vector<Edge>& edges, bool undirected = true) {
+        std::vector<OffsetT> offsets(static_cast<size_t>(numVertices) + 1, 0);
+        for (const Edge& e : edges) {
+            checkVertex(e.first, numVertices);
+            checkVertex(e.second, numVertices);
+            offsets[e.first + 1]++;
+            if (undirected) offsets[e.second + 1]++;
+        }
+        for (VertexT v = 0; v < numVertices; v++) offsets[v + 1] += offsets[v];
+
+        std::vector<VertexT> adjacency(static_cast<size_t>(offsets[numVertices]));
+        std::vector<OffsetT> cursor(offsets.begin(), offsets.end() - 1);
+        for (const Edge& e : edges) {
+            adjacency[cursor[e.first]++] = e.second;
+            if (undirected) adjacency[cursor[e.second]++] = e.first;
+        }
+        return CSRGraph(std::move(offsets), std::move(adjacency));
+    }
+
+    // Parallel build for large edge arrays: atomic degree counting, a parallel
+    // prefix sum for the offsets and a parallel scatter through per-vertex
+    // atomic cursors, with no per-vertex allocation. The scatter leaves each
+    // list in arbitrary order; sorting it afterwards is optional because it
+    // costs more than the build itself. Deduplication sorts the lists and
+    // compacts them with a second scan.
+    static CSRGraph fromEdgesParallel(VertexT numVertices, const std::vector<Edge>& edges,
+                                      const CSRBuildOptions& options = CSRBuildOptions()) {
+        const int64_t m = edges.size();
+        const bool skipLoops = options.removeSelfLoops;
+        std::vector<OffsetT> offsets(static_cast<size_t>(numVertices) + 1, 0);
+        bool badEdge = false;
+
+        #pragma omp parallel for schedule(static) reduction(||:badEdge)
+        for (int64_t i = 0; i < m; i++) {
+            VertexT u = edges[i].first, v = edges[i].second;
+            if (u < 0 || u >= numVertices || v < 0 || v >= numVertices) {
+                badEdge = true;
+                continue;
+            }
+            if (skipLoops && u == v) continue;
+            __atomic_fetch_add(&offsets[u], 1, __ATOMIC_RELAXED);
+            if (options.undirected) __atomic_fetch_add(&offsets[v], 1, __ATOMIC_RELAXED);
+        }
+        if (badEdge) throw std::out_of_range("CSRGraph: edge endpoint out of range");
+        offsets[numVertices] = parallelExclusiveScan(offsets.data(), numVertices);
+
+        std::vector<VertexT> adjacency(static_cast<size_t>(offsets[numVertices]));
+        std::vector<OffsetT> cursor(offsets.begin(), offsets.end() - 1);
+        #pragma omp parallel for schedule(static)
+        for (int64_t i = 0; i < m; i++) {
+            VertexT u = edges[i].first, v = edges[i].second;
+            if (skipLoops && u == v) continue;
+            adjacency[__atomic_fetch_add(&cursor[u], 1, __ATOMIC_RELAXED)] = v;
+            if (options.undirected) adjacency[__atomic_fetch_add(&cursor[v], 1, __ATOMIC_RELAXED)] = u;
+        }
+        std::vector<OffsetT>().swap(cursor);
+
+        if (!options.sortNeighbors && !options.removeDuplicates) {
+            return CSRGraph(std::move(offsets), std::move(adjacency));
+        }
+
+        // Sort each list; with deduplication, remember how many distinct entries remain
+        std::vector<OffsetT> kept(options.removeDuplicates ? static_cast<size_t>(numVertices) + 1 : 0, 0);
+        #pragma omp parallel for schedule(dynamic, 256)
+        for (int64_t v = 0; v < (int64_t)numVertices; v++) {
+            VertexT* first = adjacency.data() + offsets[v];
+            VertexT* last = adjacency.data() + offsets[v + 1];
+            std::sort(first, last);
+            if (options.removeDuplicates) kept[v] = std::unique(first, last) - first;
+        }
+        if (!options.removeDuplicates) {
+            return CSRGraph(std::move(offsets), std::move(adjacency));
+        }
+
+        kept[numVertices] = parallelExclusiveScan(kept.data(), numVertices);
+        std::vector<VertexT> compact(static_cast<size_t>(kept[numVertices]));
+        #pragma omp parallel for schedule(dynamic, 256)
+        for (int64_t v = 0; v < (int64_t)numVertices; v++) {
+            std::copy(adjacency.begin() + offsets[v], adjacency.begin() + offsets[v] + (kept[v + 1] - kept[v]),
+                      compact.begin() + kept[v]);
+        }
+        return CSRGraph(std::move(kept), std::move(compact));
+    }
+
+    VertexT numVertices() const { return static_cast<VertexT>(offsets_.size() - 1); }
+
+    // Number of stored arcs (twice the edge count for undirected graphs)
+    OffsetT numArcs() const { return offsets_.back(); }
+
+    OffsetT degree(VertexT v) const { return offsets_[v + 1] - offsets_[v]; }
+
+    NeighborRange neighbors(VertexT v) const {
+        const VertexT* base = adjacency_.data();
+        return {base + offsets_[v], base + offsets_[v + 1]};
+    }
+
+    const std::vector<OffsetT>& offsets() const { return offsets_; }
+    const std::vector<VertexT>& adjacency() const { return adjacency_; }
+
+    size_t memoryBytes() const {
+        return offsets_.size() * sizeof(OffsetT) + adjacency_.size() * sizeof(VertexT);
+    }
+
+private:
+    static void checkVertex(VertexT v, VertexT numVertices) {
+        if (v < 0 || v >= numVertices) {
+            throw std::out_of_range("CSRGraph: edge endpoint out of range");
+        }
+    }
+
+    std::vector<OffsetT> offsets_;
+    std::vector<VertexT> adjacency_;
+};
+
+using CSRGraph32 = CSRGraph<int32_t, int64_t>;
+using CSRGraph64 = CSRGraph<int64_t, int64_t>;
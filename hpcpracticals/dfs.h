@@ -0,0 +1,425 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <omp.h>
+#include "csr_graph.h"
+#include "parallel_utils.h"
+#include "work_stealing_deque.h"
+
+// DFS engines that run on CSRGraph and report a DFS forest
+// (parent array plus discovery/finish order) instead of printing vertices.
+
+template <typename VertexT>
+struct DFSResult {
+    std::vector<VertexT> parent;      // -1 if unreached, roots are their own parent
+    std::vector<int64_t> discovery;   // Discovery timestamp, -1 if unreached
+    std::vector<int64_t> finish;      // Finish timestamp (same clock), -1 if unreached
+    std::vector<VertexT> order;       // Vertices by discovery time
+    std::vector<VertexT> finishOrder; // Vertices by finish time
+    int64_t reached = 0;
+    int64_t steals = 0;               // Successful steals (parallel engines only)
+};
+
+// Scratch space of workStealingDFS. A caller that keeps one between runs pays
+// for the allocations once; reserve() does it up front.
+template <typename VertexT>
+struct DFSWorkspace {
+    struct Entry { VertexT vertex; VertexT from; };
+
+    std::vector<std::unique_ptr<WorkStealingDeque<Entry>>> deques; // One per thread
+    std::vector<std::vector<VertexT>> logs;                         // Vertices each thread claimed
+    std::vector<VertexT> treeOrder;                                 // Reached vertices, tree by tree
+    std::vector<int64_t> childStart, cursor;                        // Children of the DFS forest in CSR form
+    std::vector<VertexT> children, stack;
+
+    void reserve(VertexT n) {
+        const int maxThreads = omp_get_max_threads();
+        while ((int)deques.size() < maxThreads) deques.emplace_back(new WorkStealingDeque<Entry>());
+        logs.resize(maxThreads);
+        treeOrder.reserve(n);
+        childStart.reserve(static_cast<size_t>(n) + 1);
+        cursor.reserve(n);
+        children.reserve(n);
+        stack.reserve(n);
+    }
+};
+
+namespace dfs_detail {
+
+// Numbers a DFS forest after the traversal. order[0, reached) holds every
+// reached vertex, each root ahead of the vertices of its tree and the trees in
+// the order they were built. Children are grouped by parent with
+// a count, a prefix sum and a scatter, each list is sorted by position in
+// `order`, and one iterative walk assigns discovery/finish times from a single
+// clock (preorder and postorder), so every interval nests in its parent's.
+// The walk is sequential but touches each vertex twice with no atomics.
+template <typename VertexT>
+void numberForest(DFSResult<VertexT>& result, int64_t reached, DFSWorkspace<VertexT>& work) {
+    const int64_t n = result.parent.size();
+    std::vector<VertexT>& order = work.treeOrder;
+    std::vector<int64_t>& childStart = work.childStart;
+    std::vector<int64_t>& cursor = work.cursor;
+    std::vector<VertexT>& children = work.children;
+    std::vector<VertexT>& stack = work.stack;
+    order.assign(result.order.begin(), result.order.begin() + reached);
+    childStart.assign(n + 1, 0);
+
+    #pragma omp parallel for schedule(static)
+    for (int64_t i = 0; i < reached; i++) {
+        VertexT v = order[i], p = result.parent[v];
+        result.discovery[v] = i; // Sort key until the walk overwrites it
+        if (p != v) __atomic_fetch_add(&childStart[p], 1, __ATOMIC_RELAXED);
+    }
+    childStart[n] = parallelExclusiveScan(childStart.data(), (size_t)n);
+
+    children.resize(childStart[n]);
+    cursor.assign(childStart.begin(), childStart.end() - 1);
+    #pragma omp parallel for schedule(static)
+    for (int64_t i = 0; i < reached; i++) {
+        VertexT v = order[i], p = result.parent[v];
+        if (p != v) children[__atomic_fetch_add(&cursor[p], 1, __ATOMIC_RELAXED)] = v;
+    }
+    #pragma omp parallel for schedule(dynamic, 256)
+    for (int64_t v = 0; v < n; v++) {
+        std::sort(children.begin() + childStart[v], children.begin() + childStart[v + 1],
+                  [&](VertexT a, VertexT b) { return result.discovery[a] < result.discovery[b]; });
+    }
+
+    // cursor[v] walks v's children while v is on the stack
+    std::copy(childStart.begin(), childStart.end() - 1, cursor.begin());
+    stack.clear();
+    int64_t clock = 0, pre = 0, post = 0;
+    for (int64_t i = 0; i < reached; i++) {
+        VertexT root = order[i];
+        if (result.parent[root] != root) continue;
+        result.discovery[root] = clock++;
+        result.order[pre++] = root;
+        stack.push_back(root);
+        while (!stack.empty()) {
+            VertexT v = stack.back();
+            if (cursor[v] < childStart[v + 1]) {
+                VertexT c = children[cursor[v]++];
+                result.discovery[c] = clock++;
+                result.order[pre++] = c;
+                stack.push_back(c);
+            } else {
+                result.finish[v] = clock++;
+                result.finishOrder[post++] = v;
+                stack.pop_back();
+            }
+        }
+    }
+}
+
+} // namespace dfs_detail
+
+// Work-stealing parallel DFS. Each thread owns a Chase-Lev deque of
+// (vertex, pusher) entries and works depth-first off its bottom; idle threads
+// steal from the top of a random victim. A vertex belongs to whichever thread
+// first CASes its parent from -1, so nothing is locked, and that thread
+// appends it to its own discovery log, so no counter is shared by all threads.
+// Discovery/finish times and both orders are then derived from the parent
+// forest (see dfs_detail::numberForest): children are visited in the order
+// they were discovered, so with one thread the result is exactly the
+// iterative DFS. With more threads it is still a spanning forest with nested
+// discovery/finish intervals, but stolen subtrees run concurrently, so some
+// non-tree edges can become cross edges (see countCrossEdges).
+// source >= 0 explores the tree of that vertex; source < 0 builds a forest
+// over all vertices, taking roots in id order.
+// This overload fills a caller-owned result with caller-owned scratch space,
+// reusing their arrays' capacity, so repeated runs on one graph do not allocate.
+template <typename Graph>
+void workStealingDFS(const Graph& g, typename Graph::vertex_type source, DFSResult<typename Graph::vertex_type>& result,
+                     DFSWorkspace<typename Graph::vertex_type>& work) {
+    using V = typename Graph::vertex_type;
+    using Entry = typename DFSWorkspace<V>::Entry;
+    const V n = g.numVertices();
+
+    result.steals = 0;
+    result.parent.assign(n, -1);
+    result.discovery.assign(n, -1);
+    result.finish.assign(n, -1);
+    result.order.resize(n);
+    result.finishOrder.resize(n);
+    int64_t reached = 0;
+
+    const int maxThreads = omp_get_max_threads();
+    work.reserve(n);
+    auto& deques = work.deques;
+    auto& logs = work.logs;
+
+    // Push unvisited neighbours in reverse so the first neighbour is explored first
+    auto expand = [&](WorkStealingDeque<Entry>& dq, V v) {
+        auto nbrs = g.neighbors(v);
+        for (const V* it = nbrs.end(); it != nbrs.begin();) {
+            V w = *--it;
+            if (atomicLoad(result.parent[w]) < 0) dq.push({w, v});
+        }
+    };
+
+    V firstRoot = source >= 0 ? source : 0;
+    V lastRoot = source >= 0 ? source + 1 : n;
+    for (V root = firstRoot; root < lastRoot; root++) {
+        if (result.parent[root] >= 0) continue;
+        result.parent[root] = root;
+        result.order[reached++] = root;
+        expand(*deques[0], root);
+        if (deques[0]->empty()) continue; // Nothing left to explore from this root
+
+        int idle = 0;
+        int64_t steals = 0;
+        #pragma omp parallel reduction(+:steals)
+        {
+            const int tid = omp_get_thread_num();
+            const int nt = omp_get_num_threads();
+            WorkStealingDeque<Entry>& mine = *deques[tid];
+            std::vector<V>& log = logs[tid];
+            uint64_t rng = 0x9E3779B97F4A7C15ull * (uint64_t)(tid + 1);
+            Entry e;
+
+            auto process = [&](const Entry& entry) {
+                if (atomicLoad(result.parent[entry.vertex]) < 0 &&
+                    compareAndSwap(result.parent[entry.vertex], V(-1), entry.from)) {
+                    log.push_back(entry.vertex);
+                    expand(mine, entry.vertex);
+                }
+            };
+
+            for (;;) {
+                while (mine.pop(e)) process(e);
+
+                // Out of local work: steal until every thread is idle at once.
+                // Only a thread with a non-empty deque is active, so idle == nt means done.
+                __atomic_add_fetch(&idle, 1, __ATOMIC_ACQ_REL);
+                bool gotWork = false;
+                int attempts = 0;
+                while (atomicLoad(idle) < nt) {
+                    rng ^= rng << 13; rng ^= rng >> 7; rng ^= rng << 17;
+                    int victim = (int)(rng % (uint64_t)nt);
+                    if (victim == tid || deques[victim]->empty()) {
+                        if (++attempts % 64 == 0) std::this_thread::yield();
+                        continue;
+                    }
+                    __atomic_sub_fetch(&idle, 1, __ATOMIC_ACQ_REL);
+                    if (deques[victim]->steal(e)) {
+                        steals++;
+                        gotWork = true;
+                        break;
+                    }
+                    __atomic_add_fetch(&idle, 1, __ATOMIC_ACQ_REL);
+                }
+                if (!gotWork) break;
+                process(e);
+            }
+        }
+        result.steals += steals;
+
+        // The tree's vertices follow its root; with one thread this is the discovery order
+        for (int t = 0; t < maxThreads; t++) {
+            std::copy(logs[t].begin(), logs[t].end(), result.order.begin() + reached);
+            reached += logs[t].size();
+            logs[t].clear();
+        }
+    }
+
+    dfs_detail::numberForest(result, reached, work);
+    result.reached = reached;
+    result.order.resize(reached);
+    result.finishOrder.resize(reached);
+}
+
+template <typename Graph>
+void workStealingDFS(const Graph& g, typename Graph::vertex_type source, DFSResult<typename Graph::vertex_type>& result) {
+    DFSWorkspace<typename Graph::vertex_type> work;
+    workStealingDFS(g, source, result, work);
+}
+
+template <typename Graph>
+DFSResult<typename Graph::vertex_type> workStealingDFS(const Graph& g, typename Graph::vertex_type source) {
+    DFSResult<typename Graph::vertex_type> result;
+    workStealingDFS(g, source, result);
+    return result;
+}
+
+// Tuning for taskParallelDFS
+struct TaskDFSOptions {
+    int depthCutoff = 3;          // Recursion levels that spawn one task per claimed child
+    int64_t splitThreshold = 4096; // Pending stack entries before a sequential task donates half
+};
+
+namespace dfs_detail {
+
+// State shared by the tasks of one taskParallelDFS call
+template <typename Graph>
+struct TaskDFS {
+    using V = typename Graph::vertex_type;
+    struct Entry { V vertex; V from; };
+
+    const Graph& g;
+    const TaskDFSOptions& options;
+    DFSResult<V>& result;
+    Bitmap visited;
+    int64_t nextDiscovery = 0;
+
+    TaskDFS(const Graph& graph, const TaskDFSOptions& opts, DFSResult<V>& out)
+        : g(graph), options(opts), result(out), visited(graph.numVertices()) {}
+
+    void discover(V v, V from) {
+        result.parent[v] = from;
+        int64_t t = __atomic_fetch_add(&nextDiscovery, 1, __ATOMIC_RELAXED);
+        result.discovery[v] = t;
+        result.order[t] = v;
+    }
+
+    // Top of the tree: v is already claimed. Children are claimed before they
+    // are spawned, so each vertex creates at most one task.
+    void explore(V v, V from, int depth) {
+        discover(v, from);
+        for (V w : g.neighbors(v)) {
+            if (visited.test(w) || visited.testAndSet(w)) continue;
+            if (depth + 1 < options.depthCutoff) {
+                #pragma omp task firstprivate(w, v, depth)
+                explore(w, v, depth + 1);
+            } else {
+                auto* stack = new std::vector<Entry>();
+                #pragma omp task firstprivate(w, v, stack)
+                {
+                    discover(w, v);
+                    pushChildren(*stack, w);
+                    runStack(stack);
+                }
+            }
+        }
+    }
+
+    void pushChildren(std::vector<Entry>& stack, V v) {
+        auto nbrs = g.neighbors(v);
+        for (const V* it = nbrs.end(); it != nbrs.begin();) {
+            V w = *--it;
+            if (!visited.test(w)) stack.push_back({w, v});
+        }
+    }
+
+    // Iterative DFS below the cutoff, claiming vertices on pop. When the stack
+    // grows past splitThreshold, its older half (the shallowest, largest
+    // pending subtrees) becomes a new task, so a single deep task cannot hold
+    // all remaining work. Takes ownership of `stack`.
+    void runStack(std::vector<Entry>* stack) {
+        while (!stack->empty()) {
+            if ((int64_t)stack->size() > options.splitThreshold) {
+                size_t half = stack->size() / 2;
+                auto* donated = new std::vector<Entry>(stack->begin(), stack->begin() + half);
+                stack->erase(stack->begin(), stack->begin() + half);
+                #pragma omp task firstprivate(donated)
+                runStack(donated);
+            }
+            Entry e = stack->back();
+            stack->pop_back();
+            if (visited.test(e.vertex) || visited.testAndSet(e.vertex)) continue;
+            discover(e.vertex, e.from);
+            pushChildren(*stack, e.vertex);
+        }
+        delete stack;
+    }
+};
+
+} // namespace dfs_detail
+
+// Task-parallel recursive DFS: a single parallel region whose tasks recurse
+// on children only above `depthCutoff`; below it each task runs an iterative
+// DFS on its own stack and hands off half the stack when it gets large.
+// Visited is an atomic bitmap, so every vertex is discovered exactly once.
+// The result is a spanning tree of the source's component with parent,
+// discovery and order filled in; finish times are not tracked (-1).
+template <typename Graph>
+DFSResult<typename Graph::vertex_type> taskParallelDFS(const Graph& g, typename Graph::vertex_type source,
+                                                       const TaskDFSOptions& options = TaskDFSOptions()) {
+    using V = typename Graph::vertex_type;
+    const V n = g.numVertices();
+    DFSResult<V> result;
+    result.parent.assign(n, -1);
+    result.discovery.assign(n, -1);
+    result.finish.assign(n, -1);
+    result.order.resize(n);
+
+    dfs_detail::TaskDFS<Graph> dfs(g, options, result);
+    dfs.visited.set(source);
+    #pragma omp parallel
+    #pragma omp single
+    dfs.explore(source, source, 0);
+
+    result.reached = dfs.nextDiscovery;
+    result.order.resize(result.reached);
+    return result;
+}
+
+// Checks a search tree without finish times: every non-root vertex hangs off
+// a neighbour discovered before it, and no edge leaves the reached set.
+template <typename Graph>
+bool validateSearchTree(const Graph& g, const DFSResult<typename Graph::vertex_type>& result) {
+    using V = typename Graph::vertex_type;
+    const V n = g.numVertices();
+    bool ok = true;
+
+    #pragma omp parallel for schedule(dynamic, 1024) reduction(&&:ok)
+    for (int64_t v = 0; v < (int64_t)n; v++) {
+        V p = result.parent[v];
+        if (p < 0) continue;
+        bool adjacent = p == v;
+        for (V w : g.neighbors((V)v)) {
+            if (w == p) adjacent = true;
+            ok = ok && result.parent[w] >= 0;
+        }
+        ok = ok && adjacent && result.discovery[p] <= result.discovery[v];
+    }
+    return ok;
+}
+
+// Checks the forest structure: every non-root vertex hangs off a neighbour
+// whose discovery/finish interval strictly contains its own.
+template <typename Graph>
+bool validateDFSForest(const Graph& g, const DFSResult<typename Graph::vertex_type>& result) {
+    using V = typename Graph::vertex_type;
+    const V n = g.numVertices();
+    bool ok = (int64_t)result.finishOrder.size() == result.reached;
+
+    #pragma omp parallel for schedule(dynamic, 1024) reduction(&&:ok)
+    for (int64_t v = 0; v < (int64_t)n; v++) {
+        V p = result.parent[v];
+        if (p < 0) {
+            ok = ok && result.discovery[v] < 0;
+        } else if (p != v) {
+            bool adjacent = false;
+            for (V w : g.neighbors((V)v)) {
+                if (w == p) { adjacent = true; break; }
+            }
+            ok = ok && adjacent && result.discovery[p] < result.discovery[v] &&
+                 result.finish[v] < result.finish[p];
+        }
+    }
+    return ok;
+}
+
+// Counts edges between reached vertices whose intervals are disjoint.
+// A depth-first forest of an undirected graph has none.
+template <typename Graph>
+int64_t countCrossEdges(const Graph& g, const DFSResult<typename Graph::vertex_type>& result) {
+    using V = typename Graph::vertex_type;
+    const V n = g.numVertices();
+    int64_t cross = 0;
+
+    #pragma omp parallel for schedule(dynamic, 1024) reduction(+:cross)
+    for (int64_t u = 0; u < (int64_t)n; u++) {
+        if (result.discovery[u] < 0) continue;
+        for (V w : g.neighbors((V)u)) {
+            if (w <= u || result.discovery[w] < 0) continue;
+            bool disjoint = result.finish[u] < result.discovery[w] || result.finish[w] < result.discovery[u];
+            if (disjoint) cross++;
+        }
+    }
+    return cross;
+}
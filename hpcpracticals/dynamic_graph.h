@@ -0,0 +1,319 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <omp.h>
+#include "csr_graph.h"
+#include "bfs.h"
+#include "parallel_utils.h"
+
+// Batched updates for an undirected graph with sorted neighbour lists, and
+// BFS distances that are repaired after a batch instead of recomputed.
+
+// Undirected graph that takes batched edge updates in place. It is a CSR base
+// plus an overflow slot for every vertex touched since the last compaction,
+// holding that vertex's whole current neighbour list. neighbors() returns one
+// or the other, so every engine written against CSRGraph runs on it
+// unchanged. A batch costs the degrees of the vertices it touches, not the size
+// of the graph. Once the overflow lists hold more than compactFraction of the
+// base arcs, they are folded back into a fresh CSR in one parallel pass.
+template <typename VertexT = int32_t, typename OffsetT = int64_t>
+class DynamicGraph {
+public:
+    using vertex_type = VertexT;
+    using offset_type = OffsetT;
+    using Edge = std::pair<VertexT, VertexT>;
+    using Base = CSRGraph<VertexT, OffsetT>;
+    using NeighborRange = typename Base::NeighborRange;
+
+    DynamicGraph() = default;
+
+    // base must have sorted neighbour lists
+    explicit DynamicGraph(Base base, double compactFraction = 0.1)
+        : base_(std::move(base)), slot_(static_cast<size_t>(base_.numVertices()), -1), arcs_(base_.numArcs()),
+          compactFraction_(compactFraction) {}
+
+    VertexT numVertices() const { return base_.numVertices(); }
+    OffsetT numArcs() const { return arcs_; }
+    OffsetT degree(VertexT v) const { return static_cast<OffsetT>(neighbors(v).size()); }
+
+    NeighborRange neighbors(VertexT v) const {
+        const VertexT s = slot_[v];
+        if (s < 0) return base_.neighbors(v);
+        const std::vector<VertexT>& list = overflow_[s];
+        return {list.data(), list.data() + list.size()};
+    }
+
+    // Vertices whose list lives in an overflow slot, and compactions so far
+    size_t touchedVertices() const { return touched_.size(); }
+    int compactions() const { return compactions_; }
+
+    // Applies deletions first, then insertions, so an edge in both lists ends
+    // up present. Inserting an existing edge or deleting a missing one does
+    // nothing, and self loops are ignored. The batch's arcs are sorted by
+    // source; each touched list is then edited in parallel (copied out of the
+    // base on first touch), keeping it sorted.
+    void applyBatch(const std::vector<Edge>& insertions, const std::vector<Edge>& deletions) {
+        struct Arc { VertexT from, to; bool insert; };
+        std::vector<Arc> arcs;
+        arcs.reserve(2 * (insertions.size() + deletions.size()));
+        auto add = [&](const std::vector<Edge>& edges, bool insert) {
+            for (const Edge& e : edges) {
+                checkVertex(e.first);
+                checkVertex(e.second);
+                if (e.first == e.second) continue;
+                arcs.push_back({e.first, e.second, insert});
+                arcs.push_back({e.second, e.first, insert});
+            }
+        };
+        add(deletions, false);
+        add(insertions, true);
+        std::sort(arcs.begin(), arcs.end(), [](const Arc& a, const Arc& b) {
+            if (a.from != b.from) return a.from < b.from;
+            if (a.insert != b.insert) return !a.insert;
+            return a.to < b.to;
+        });
+
+        // One run of arcs per touched vertex; slots are handed out serially
+        std::vector<size_t> runStart;
+        std::vector<char> fresh;
+        for (size_t i = 0; i < arcs.size(); i++) {
+            if (i > 0 && arcs[i].from == arcs[i - 1].from) continue;
+            const VertexT v = arcs[i].from;
+            runStart.push_back(i);
+            fresh.push_back(slot_[v] < 0);
+            if (slot_[v] < 0) {
+                slot_[v] = static_cast<VertexT>(touched_.size());
+                touched_.push_back(v);
+                overflow_.emplace_back();
+            }
+        }
+        runStart.push_back(arcs.size());
+
+        const int64_t runs = (int64_t)runStart.size() - 1;
+        int64_t arcDelta = 0, overflowDelta = 0;
+        #pragma omp parallel for schedule(dynamic, 16) reduction(+:arcDelta, overflowDelta)
+        for (int64_t r = 0; r < runs; r++) {
+            const Arc* first = arcs.data() + runStart[r];
+            const Arc* last = arcs.data() + runStart[r + 1];
+            const VertexT v = first->from;
+            std::vector<VertexT>& list = overflow_[slot_[v]];
+            if (fresh[r]) {
+                list.assign(base_.neighbors(v).begin(), base_.neighbors(v).end());
+                overflowDelta += list.size();
+            }
+            const int64_t before = list.size();
+
+            const Arc* split = first;
+            while (split != last && !split->insert) split++;
+            if (split != first) {
+                auto deleted = [&](VertexT w) {
+                    const Arc* it = std::lower_bound(first, split, w, [](const Arc& a, VertexT x) { return a.to < x; });
+                    return it != split && it->to == w;
+                };
+                list.erase(std::remove_if(list.begin(), list.end(), deleted), list.end());
+            }
+            const size_t kept = list.size();
+            for (const Arc* it = split; it != last; it++) {
+                if (it != split && it->to == (it - 1)->to) continue;
+                if (!std::binary_search(list.begin(), list.begin() + kept, it->to)) list.push_back(it->to);
+            }
+            std::inplace_merge(list.begin(), list.begin() + kept, list.end());
+
+            arcDelta += (int64_t)list.size() - before;
+            overflowDelta += (int64_t)list.size() - before;
+        }
+        arcs_ += arcDelta;
+        overflowArcs_ += overflowDelta;
+        if ((double)overflowArcs_ > compactFraction_ * (double)base_.numArcs()) compact();
+    }
+
+    // Folds the overflow lists back into the base CSR (degrees, prefix sum, copy)
+    void compact() {
+        const VertexT n = numVertices();
+        std::vector<OffsetT> offsets(static_cast<size_t>(n) + 1, 0);
+        #pragma omp parallel for schedule(static)
+        for (int64_t v = 0; v < (int64_t)n; v++) offsets[v] = degree((VertexT)v);
+        offsets[n] = parallelExclusiveScan(offsets.data(), (size_t)n);
+
+        std::vector<VertexT> adjacency(static_cast<size_t>(offsets[n]));
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for (int64_t v = 0; v < (int64_t)n; v++) {
+            NeighborRange nbrs = neighbors((VertexT)v);
+            std::copy(nbrs.begin(), nbrs.end(), adjacency.begin() + offsets[v]);
+        }
+        base_ = Base(std::move(offsets), std::move(adjacency));
+
+        for (VertexT v : touched_) slot_[v] = -1;
+        touched_.clear();
+        overflow_.clear();
+        overflowArcs_ = 0;
+        compactions_++;
+    }
+
+private:
+    void checkVertex(VertexT v) const {
+        if (v < 0 || v >= numVertices()) throw std::out_of_range("DynamicGraph: edge endpoint out of range");
+    }
+
+    Base base_;
+    std::vector<VertexT> slot_;                  // Overflow slot of each vertex, -1 if it uses the base
+    std::vector<std::vector<VertexT>> overflow_; // Current lists of the touched vertices
+    std::vector<VertexT> touched_;               // Vertex of each slot
+    OffsetT arcs_ = 0;
+    int64_t overflowArcs_ = 0;
+    double compactFraction_ = 0.1;
+    int compactions_ = 0;
+};
+
+// Tuning for repairBFS
+struct BFSRepairOptions {
+    double maxBatchFraction = 0.05;      // Recompute when the batch exceeds this share of the edges
+    double maxInvalidatedFraction = 0.1; // ... or when deletions cut off this share of the vertices
+};
+
+struct BFSRepairStats {
+    bool recomputed = false; // Fell back to a full BFS
+    int64_t invalidated = 0; // Vertices cut off from the source by deleted tree edges
+    int64_t updated = 0;     // Vertices whose distance was lowered during the repair
+};
+
+// Repairs a BFS (distance = level, -1 if unreached; parent, source is its own)
+// from `source` after `insertions` and `deletions` turned the old graph into g
+// (typically a DynamicGraph after applyBatch, so no rebuild precedes the repair).
+//  1. Deleting a tree edge orphans the child; the orphan's whole subtree is
+//     invalidated (walked through parent pointers, level by level). Every
+//     other vertex keeps an intact tree path, so its distance is still an
+//     upper bound and, under deletions alone, exact.
+//  2. Seeds: an invalidated vertex may attach to its best valid neighbour,
+//     and an inserted edge may shorten the path to one of its endpoints.
+//  3. Seeds are bucketed by distance and relaxed in increasing order like a
+//     BFS (atomic lowering of the distance), which fixes exactly the vertices
+//     whose distance changed.
+// Large batches or large invalidated regions fall back to frontierBFS.
+template <typename Graph>
+BFSRepairStats repairBFS(const Graph& g, typename Graph::vertex_type source,
+                         const std::vector<std::pair<typename Graph::vertex_type, typename Graph::vertex_type>>& insertions,
+                         const std::vector<std::pair<typename Graph::vertex_type, typename Graph::vertex_type>>& deletions,
+                         std::vector<int32_t>& distance, std::vector<typename Graph::vertex_type>& parent,
+                         const BFSRepairOptions& options = BFSRepairOptions()) {
+    using V = typename Graph::vertex_type;
+    const V n = g.numVertices();
+    BFSRepairStats stats;
+
+    auto recompute = [&]() {
+        BFSResult<V> full;
+        full.level.swap(distance);
+        full.parent.swap(parent);
+        frontierBFS(g, source, full);
+        full.level.swap(distance);
+        full.parent.swap(parent);
+        stats.recomputed = true;
+        return stats;
+    };
+    if ((double)(insertions.size() + deletions.size()) > options.maxBatchFraction * (g.numArcs() / 2 + 1)) {
+        return recompute();
+    }
+
+    // 1. Invalidate the subtrees below deleted tree edges
+    Bitmap invalid(n);
+    std::vector<V> frontier, next;
+    for (const auto& e : deletions) {
+        V u = e.first, v = e.second;
+        if (u == v) continue;
+        if (parent[v] == u && v != source && !invalid.testAndSet(v)) frontier.push_back(v);
+        if (parent[u] == v && u != source && !invalid.testAndSet(u)) frontier.push_back(u);
+    }
+    std::vector<V> invalidated(frontier);
+    const int maxThreads = omp_get_max_threads();
+    std::vector<std::vector<V>> buffers(maxThreads);
+    while (!frontier.empty()) {
+        #pragma omp parallel
+        {
+            std::vector<V>& local = buffers[omp_get_thread_num()];
+            local.clear();
+            #pragma omp for schedule(dynamic, 64)
+            for (int64_t i = 0; i < (int64_t)frontier.size(); i++) {
+                V x = frontier[i];
+                for (V w : g.neighbors(x)) {
+                    if (parent[w] == x && w != x && !invalid.test(w) && !invalid.testAndSet(w)) local.push_back(w);
+                }
+            }
+        }
+        next.clear();
+        for (int t = 0; t < maxThreads; t++) next.insert(next.end(), buffers[t].begin(), buffers[t].end());
+        invalidated.insert(invalidated.end(), next.begin(), next.end());
+        frontier.swap(next);
+        if ((double)invalidated.size() > options.maxInvalidatedFraction * n) return recompute();
+    }
+    stats.invalidated = invalidated.size();
+
+    #pragma omp parallel for schedule(static)
+    for (int64_t i = 0; i < (int64_t)invalidated.size(); i++) {
+        distance[invalidated[i]] = -1;
+        parent[invalidated[i]] = -1;
+    }
+
+    // 2. Seeds with their candidate distances
+    std::vector<std::vector<V>> buckets;
+    auto addSeed = [&](V v, V from, int32_t d) {
+        if (distance[v] >= 0 && distance[v] <= d) return;
+        distance[v] = d;
+        parent[v] = from;
+        if ((size_t)d >= buckets.size()) buckets.resize(d + 1);
+        buckets[d].push_back(v);
+    };
+    for (V x : invalidated) {
+        for (V y : g.neighbors(x)) {
+            if (distance[y] >= 0 && !invalid.test(y)) addSeed(x, y, distance[y] + 1);
+        }
+    }
+    for (const auto& e : insertions) {
+        V u = e.first, v = e.second;
+        if (distance[u] >= 0) addSeed(v, u, distance[u] + 1);
+        if (distance[v] >= 0) addSeed(u, v, distance[v] + 1);
+    }
+
+    // 3. Relax in increasing distance; a vertex is expanded from the bucket of its final distance
+    auto lower = [&](V w, int32_t d) {
+        int32_t current = atomicLoad(distance[w]);
+        while (current < 0 || d < current) {
+            if (__atomic_compare_exchange_n(&distance[w], &current, d, true, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+                return true;
+            }
+        }
+        return false;
+    };
+    int64_t updated = 0;
+    for (size_t d = 0; d < buckets.size(); d++) {
+        if (buckets[d].empty()) continue;
+        std::vector<V> current;
+        current.swap(buckets[d]);
+        #pragma omp parallel reduction(+:updated)
+        {
+            std::vector<V>& local = buffers[omp_get_thread_num()];
+            local.clear();
+            #pragma omp for schedule(dynamic, 64)
+            for (int64_t i = 0; i < (int64_t)current.size(); i++) {
+                V x = current[i];
+                if (distance[x] != (int32_t)d) continue; // Stale entry or already expanded
+                updated++;
+                for (V w : g.neighbors(x)) {
+                    if (lower(w, (int32_t)d + 1)) {
+                        parent[w] = x;
+                        local.push_back(w);
+                    }
+                }
+            }
+        }
+        if (d + 1 >= buckets.size()) buckets.resize(d + 2);
+        for (int t = 0; t < maxThreads; t++) {
+            buckets[d + 1].insert(buckets[d + 1].end(), buffers[t].begin(), buffers[t].end());
+        }
+    }
+    stats.updated = updated;
+    return stats;
+}
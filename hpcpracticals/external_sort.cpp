@@ -0,0 +1,167 @@
+#include <iostream>
+#include <omp.h>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <iomanip>
+#include <chrono>
+#include <stdexcept>
+#include "external_sort.h"
+#include "simd_sort.h"
+
+using namespace std;
+
+// Writes `count` random ints to path in blocks generated in parallel
+void generateKeys(const string& path, long long count, unsigned seed) {
+    const long long block = 1 << 22;
+    vector<int> buffer(block);
+    FILE* f = fopen(path.c_str(), "wb");
+    if (!f) throw runtime_error("cannot create " + path);
+    for (long long done = 0; done < count; done += block) {
+        const long long n = min(block, count - done);
+        #pragma omp parallel for schedule(static)
+        for (long long i = 0; i < n; i++) {
+            uint64_t x = (uint64_t)(done + i) * 0x9E3779B97F4A7C15ULL + seed;
+            x = (x ^ (x >> 31)) * 0xBF58476D1CE4E5B9ULL;
+            buffer[i] = (int)(x >> 33);
+        }
+        if (fwrite(buffer.data(), sizeof(int), n, f) != (size_t)n) {
+            fclose(f);
+            throw runtime_error("short write to " + path);
+        }
+    }
+    fclose(f);
+}
+
+// Streams through path checking order; returns the number of keys, or -1 if unsorted
+long long verifySorted(const string& path) {
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) throw runtime_error("cannot open " + path);
+    vector<int> buffer(1 << 22);
+    long long count = 0;
+    int previous = 0;
+    bool sorted = true;
+    size_t n;
+    while (sorted && (n = fread(buffer.data(), sizeof(int), buffer.size(), f)) > 0) {
+        for (size_t i = 0; i < n; i++) {
+            if (count + (long long)i > 0 && buffer[i] < previous) sorted = false;
+            previous = buffer[i];
+        }
+        count += n;
+    }
+    fclose(f);
+    return sorted ? count : -1;
+}
+
+int main(int argc, char* argv[]) {
+    // --input <file> --output <file> [--memory MB] [--temp dir] [--threads t] [--verify] [--quiet]
+    // --generate <count> <file>: write random 32-bit keys to sort
+    string input, output;
+    ExternalSortOptions options;
+    long long memoryMB = 256;
+    bool verify = false, quiet = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--input") == 0 && i + 1 < argc) input = argv[++i];
+        else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) output = argv[++i];
+        else if (strcmp(argv[i], "--memory") == 0 && i + 1 < argc) memoryMB = atoll(argv[++i]);
+        else if (strcmp(argv[i], "--temp") == 0 && i + 1 < argc) options.tempDir = argv[++i];
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) omp_set_num_threads(atoi(argv[++i]));
+        else if (strcmp(argv[i], "--verify") == 0) verify = true;
+        else if (strcmp(argv[i], "--quiet") == 0) quiet = true;
+        else if (strcmp(argv[i], "--generate") == 0 && i + 2 < argc) {
+            long long count = atoll(argv[i + 1]);
+            string path = argv[i + 2];
+            i += 2;
+            auto start = chrono::steady_clock::now();
+            generateKeys(path, count, 42);
+            double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            cout << "Generated " << count << " keys (" << count * sizeof(int) / 1048576.0 << " MB) in " << secs
+                 << " seconds\n";
+        } else {
+            cout << "Usage: " << argv[0] << " --input <file> --output <file> [--memory MB] [--temp dir] [--threads t]"
+                 << " [--verify] [--quiet]\n       " << argv[0] << " --generate <count> <file>\n";
+            return 1;
+        }
+    }
+    if (input.empty() || output.empty()) return 0; // Generate only
+    if (memoryMB < 1) {
+        cout << "Memory budget must be at least 1 MB.\n";
+        return 1;
+    }
+    options.memoryBytes = (size_t)memoryMB << 20;
+    options.minBlockBytes = min<size_t>(options.minBlockBytes, options.memoryBytes / 16);
+    if (!quiet) options.progress = &cout;
+
+    // Chunks are sorted by the ping-pong merge sort with the SIMD base case;
+    // its arena is the second half of the memory budget, reused by every chunk
+    MergeSortArena<int> arena;
+    const SimdLevel leafLevel = detectSimdLevel();
+    auto sortChunk = [&](int* data, size_t n) {
+        if (leafLevel != SimdLevel::Scalar) {
+            pingPongMergeSort(data, n, arena, less<int>(),
+                              [leafLevel](int* leaf, size_t count) { simdSortSmall(leaf, (int)count, leafLevel); },
+                              kSimdLeaf);
+        } else {
+            pingPongMergeSort(data, n, arena);
+        }
+    };
+
+    cout << "Sorting " << input << " with a " << memoryMB << " MB budget, " << omp_get_max_threads() << " threads, "
+         << simdLevelName(leafLevel) << " base case\n";
+    try {
+        ExternalSortStats stats = externalSort<int>(input, output, options, less<int>(), sortChunk);
+        const double mb = stats.elements * sizeof(int) / 1048576.0;
+        cout << fixed << setprecision(3);
+        cout << "Keys: " << stats.elements << " (" << mb << " MB), " << stats.runs << " runs, " << stats.mergePasses
+             << " merge passes\n";
+        cout << "Read: " << stats.bytesRead / 1048576.0 << " MB in " << stats.readSeconds << " s ("
+             << external_detail::mbPerSecond(stats.bytesRead, stats.readSeconds) << " MB/s)\n";
+        cout << "Write: " << stats.bytesWritten / 1048576.0 << " MB in " << stats.writeSeconds << " s ("
+             << external_detail::mbPerSecond(stats.bytesWritten, stats.writeSeconds) << " MB/s)\n";
+        cout << "Chunk sorting: " << stats.sortSeconds << " s, merging: " << stats.mergeSeconds
+             << " s, deleting runs: " << stats.cleanupSeconds << " s\n";
+        cout << "Total: " << stats.totalSeconds << " s ("
+             << external_detail::mbPerSecond(stats.elements * sizeof(int), stats.totalSeconds) << " MB/s end to end)\n";
+        if (verify) {
+            long long count = verifySorted(output);
+            cout << (count == (long long)stats.elements ? "Output is sorted and complete\n"
+                                                         : "Output is NOT sorted or incomplete\n");
+        }
+    } catch (const exception& e) {
+        cout << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+/*$ ./external_sort.exe --generate 100000000 keys.bin
+Generated 100000000 keys (381.47 MB) in 0.161253 seconds
+$ ./external_sort.exe --input keys.bin --output sorted.bin --memory 128 --verify
+Sorting keys.bin with a 128 MB budget, 1 threads, AVX-512 base case
+run 1/6: 64.0 MB, read 15513.0 MB/s, sorted in 0.653 s, written 2345.3 MB/s
+run 2/6: 64.0 MB, read 17733.4 MB/s, sorted in 0.652 s, written 2313.3 MB/s
+run 3/6: 64.0 MB, read 17881.5 MB/s, sorted in 0.641 s, written 2593.3 MB/s
+run 4/6: 64.0 MB, read 16909.0 MB/s, sorted in 0.655 s, written 2742.5 MB/s
+run 5/6: 64.0 MB, read 17246.9 MB/s, sorted in 0.639 s, written 2528.0 MB/s
+run 6/6: 61.5 MB, read 17206.3 MB/s, sorted in 0.619 s, written 2772.5 MB/s
+merge pass 1: 12% of 6 runs, 275.2 MB/s
+merge pass 1: 22% of 6 runs, 275.3 MB/s
+merge pass 1: 31% of 6 runs, 278.2 MB/s
+merge pass 1: 41% of 6 runs, 281.7 MB/s
+merge pass 1: 50% of 6 runs, 282.5 MB/s
+merge pass 1: 62% of 6 runs, 280.8 MB/s
+merge pass 1: 72% of 6 runs, 280.7 MB/s
+merge pass 1: 81% of 6 runs, 264.7 MB/s
+merge pass 1: 91% of 6 runs, 264.9 MB/s
+merge pass 1: 100% of 6 runs, 266.6 MB/s
+merge pass 1: 6 runs -> 1 (1 key ranges)
+Keys: 100000000 (381.470 MB), 6 runs, 1 merge passes
+Read: 762.939 MB in 0.043 s (17936.152 MB/s)
+Write: 762.939 MB in 0.344 s (2221.003 MB/s)
+Chunk sorting: 3.858 s, merging: 1.431 s, deleting runs: 11.625 s
+Total: 17.100 s (22.308 MB/s end to end)
+Output is sorted and complete
+*/
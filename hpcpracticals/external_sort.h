@@ -0,0 +1,514 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <iomanip>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <omp.h>
+#include "pingpong_merge_sort.h"
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Out-of-core sort of a binary file of T (native byte order) within a fixed
+// memory budget: sorted runs are spilled to temporary files, then merged
+// k ways with a loser tree, in as many passes as the budget requires.
+
+struct ExternalSortOptions {
+    size_t memoryBytes = (size_t)256 << 20; // Budget for chunk data, scratch and merge buffers
+    size_t minBlockBytes = (size_t)1 << 20; // Smallest read buffer per run during a merge
+    std::string tempDir = ".";              // Where the runs are spilled
+    std::ostream* progress = nullptr;       // Per-run and per-merge progress lines when set
+};
+
+struct ExternalSortStats {
+    size_t elements = 0;
+    size_t runs = 0;       // Sorted runs written by the first phase
+    int mergePasses = 0;   // Passes over the data after the first phase
+    size_t bytesRead = 0;  // Including re-reads of the runs
+    size_t bytesWritten = 0;
+    double readSeconds = 0, sortSeconds = 0, writeSeconds = 0, mergeSeconds = 0, totalSeconds = 0;
+    double cleanupSeconds = 0; // Deleting merged runs (may wait for their writeback)
+};
+
+namespace external_detail {
+
+inline double seconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+inline double mbPerSecond(size_t bytes, double secs) { return secs > 0 ? bytes / 1048576.0 / secs : 0; }
+
+// FILE* that is closed on scope exit, opened for sequential access
+struct File {
+    FILE* f = nullptr;
+
+    File(const std::string& path, const char* mode) : f(std::fopen(path.c_str(), mode)) {
+        if (!f) throw std::runtime_error("cannot open " + path);
+        std::setvbuf(f, nullptr, _IONBF, 0); // Our blocks are already large
+#if !defined(_WIN32) && defined(POSIX_FADV_SEQUENTIAL)
+        posix_fadvise(fileno(f), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    }
+    ~File() {
+        if (f) std::fclose(f);
+    }
+    File(const File&) = delete;
+    File& operator=(const File&) = delete;
+};
+
+// Temporary runs of one sort: names are unique to this process and call, and
+// any run still on disk is removed on scope exit, including after a throw
+class RunSet {
+public:
+    explicit RunSet(const std::string& dir) {
+        static std::atomic<unsigned> sorts{0};
+#ifdef _WIN32
+        const int pid = _getpid();
+#else
+        const int pid = (int)getpid();
+#endif
+        tag = "extsort_" + std::to_string(pid) + "_" + std::to_string(sorts++);
+        prefix = dir + "/" + tag + "_";
+    }
+    ~RunSet() {
+        for (const std::string& path : live) std::remove(path.c_str());
+    }
+    RunSet(const RunSet&) = delete;
+    RunSet& operator=(const RunSet&) = delete;
+
+    // Registers the name before the file is created, so a partial run is removed too
+    std::string create(int pass, size_t i) {
+        live.push_back(prefix + std::to_string(pass) + "_" + std::to_string(i) + ".run");
+        return live.back();
+    }
+
+    // Name under which `path` is written before being renamed into place; it
+    // sits in the same directory, so the rename never crosses file systems
+    std::string createBeside(const std::string& path) {
+        live.push_back(path + "." + tag + ".tmp");
+        return live.back();
+    }
+
+    void remove(const std::string& path) {
+        std::remove(path.c_str());
+        release(path);
+    }
+
+    // Stops tracking a run that now lives on under another name
+    void release(const std::string& path) { live.erase(std::find(live.begin(), live.end(), path)); }
+
+private:
+    std::string tag, prefix;
+    std::vector<std::string> live;
+};
+
+// Renames from over to, replacing any existing file; POSIX rename does that
+// atomically, Windows refuses to replace, so the old file is removed first
+inline bool replaceFile(const std::string& from, const std::string& to) {
+#ifdef _WIN32
+    std::remove(to.c_str());
+#endif
+    return std::rename(from.c_str(), to.c_str()) == 0;
+}
+
+inline size_t fileSize(const std::string& path) {
+    File file(path, "rb");
+    std::fseek(file.f, 0, SEEK_END);
+#ifdef _WIN32
+    long long size = _ftelli64(file.f);
+#else
+    long long size = ftello(file.f);
+#endif
+    if (size < 0) throw std::runtime_error("cannot size " + path);
+    return (size_t)size;
+}
+
+inline void seekTo(FILE* f, size_t offset) {
+#ifdef _WIN32
+    const int failed = _fseeki64(f, (long long)offset, SEEK_SET);
+#else
+    const int failed = fseeko(f, (off_t)offset, SEEK_SET);
+#endif
+    if (failed) throw std::runtime_error("seek failed");
+}
+
+// Bytes and time spent on I/O by one merge
+struct IOCounters {
+    size_t bytesRead = 0, bytesWritten = 0;
+    double readSeconds = 0, writeSeconds = 0;
+
+    void add(const IOCounters& o) {
+        bytesRead += o.bytesRead;
+        bytesWritten += o.bytesWritten;
+        readSeconds += o.readSeconds;
+        writeSeconds += o.writeSeconds;
+    }
+};
+
+// Sequential reader of elements [begin, end) of a sorted run through a fixed block
+template <typename T>
+class RunReader {
+public:
+    RunReader(const std::string& path, size_t begin, size_t end, T* block, size_t blockElements, IOCounters& io)
+        : file(new File(path, "rb")), block(block), capacity(blockElements), remaining(end - begin), io(&io) {
+        seekTo(file->f, begin * sizeof(T));
+        refill();
+    }
+
+    bool done() const { return pos == count; }
+    const T& head() const { return block[pos]; }
+
+    void advance() {
+        if (++pos == count) refill();
+    }
+
+private:
+    void refill() {
+        auto start = std::chrono::steady_clock::now();
+        count = std::fread(block, sizeof(T), std::min(capacity, remaining), file->f);
+        remaining -= count;
+        pos = 0;
+        io->bytesRead += count * sizeof(T);
+        io->readSeconds += seconds(start);
+    }
+
+    std::unique_ptr<File> file;
+    T* block;
+    size_t capacity, remaining, pos = 0, count = 0;
+    IOCounters* io;
+};
+
+// Tournament tree of losers over k sources: the root holds the source with
+// the smallest head and every inner node the loser of the match played
+// there, so replacing the winner replays only its leaf-to-root path
+// (log2 k comparisons, against losers already in hand). Heads are cached
+// next to the tree so the matches do not go through the readers. An
+// exhausted source loses every match; ties go to the lower source index,
+// keeping the merge stable across runs.
+template <typename T, typename Less>
+class LoserTree {
+public:
+    LoserTree(std::vector<RunReader<T>>& sources, Less less)
+        : sources(sources), less(less), k(sources.size()), heads(k), live(k) {
+        for (size_t i = 0; i < k; i++) {
+            live[i] = !sources[i].done();
+            if (live[i]) heads[i] = sources[i].head();
+        }
+        tree.assign(std::max<size_t>(k, 1), 0);
+        std::vector<size_t> winner(2 * k);
+        for (size_t i = 0; i < k; i++) winner[k + i] = i;
+        for (size_t node = k - 1; node >= 1; node--) {
+            size_t a = winner[2 * node], b = winner[2 * node + 1];
+            if (beats(a, b)) {
+                winner[node] = a;
+                tree[node] = b;
+            } else {
+                winner[node] = b;
+                tree[node] = a;
+            }
+        }
+        tree[0] = k > 1 ? winner[1] : 0;
+    }
+
+    bool empty() const { return !live[tree[0]]; }
+    const T& top() const { return heads[tree[0]]; }
+
+    // Advances the winning source and replays its path
+    void pop() {
+        size_t w = tree[0];
+        RunReader<T>& source = sources[w];
+        source.advance();
+        live[w] = !source.done();
+        if (live[w]) heads[w] = source.head();
+        for (size_t node = (w + k) / 2; node >= 1; node /= 2) {
+            if (beats(tree[node], w)) std::swap(tree[node], w);
+        }
+        tree[0] = w;
+    }
+
+private:
+    bool beats(size_t a, size_t b) const {
+        if (!live[a]) return false;
+        if (!live[b]) return true;
+        if (less(heads[a], heads[b])) return true;
+        if (less(heads[b], heads[a])) return false;
+        return a < b;
+    }
+
+    std::vector<RunReader<T>>& sources;
+    Less less;
+    size_t k;
+    std::vector<T> heads;
+    std::vector<char> live;
+    std::vector<size_t> tree;
+};
+
+// Merges runs[i][begin[i], end[i]) for every i into out at its current
+// position. memory[0, memoryElements) is split into one read block per run
+// and one write block; onFlush(elements) is called after every block written.
+template <typename T, typename Less, typename OnFlush>
+IOCounters mergeToFile(const std::vector<std::string>& runs, const std::vector<size_t>& begin,
+                       const std::vector<size_t>& end, FILE* out, T* memory, size_t memoryElements, Less less,
+                       OnFlush onFlush) {
+    IOCounters io;
+    const size_t k = runs.size();
+    const size_t blockElements = std::max<size_t>(1, memoryElements / (k + 1));
+    std::vector<RunReader<T>> sources;
+    sources.reserve(k);
+    for (size_t i = 0; i < k; i++) sources.emplace_back(runs[i], begin[i], end[i], memory + i * blockElements, blockElements, io);
+    LoserTree<T, Less> tree(sources, less);
+
+    T* outBlock = memory + k * blockElements;
+    size_t filled = 0;
+    auto flush = [&] {
+        auto start = std::chrono::steady_clock::now();
+        if (std::fwrite(outBlock, sizeof(T), filled, out) != filled) throw std::runtime_error("short write");
+        io.writeSeconds += seconds(start);
+        io.bytesWritten += filled * sizeof(T);
+        onFlush(filled);
+        filled = 0;
+    };
+    while (!tree.empty()) {
+        outBlock[filled++] = tree.top();
+        tree.pop();
+        if (filled == blockElements) flush();
+    }
+    flush();
+    return io;
+}
+
+template <typename T>
+T readAt(FILE* f, size_t index) {
+    T value;
+    seekTo(f, index * sizeof(T));
+    if (std::fread(&value, sizeof(T), 1, f) != 1) throw std::runtime_error("short read");
+    return value;
+}
+
+// Cuts every run so that piece p of each (cuts[p][r] to cuts[p + 1][r])
+// holds the keys between splitters p - 1 and p. The splitters are quantiles
+// of 16 evenly spaced keys per run and part, and each cut is the splitter's
+// lower bound, found by binary search with single-key reads.
+template <typename T, typename Less>
+std::vector<std::vector<size_t>> splitRuns(const std::vector<std::string>& runs, const std::vector<size_t>& lengths,
+                                           int parts, Less less) {
+    const size_t k = runs.size(), perRun = 16 * (size_t)parts;
+    std::vector<T> sample;
+    for (size_t r = 0; r < k; r++) {
+        File f(runs[r], "rb");
+        for (size_t i = 0; i < perRun && lengths[r] > 0; i++) sample.push_back(readAt<T>(f.f, lengths[r] * i / perRun));
+    }
+    std::sort(sample.begin(), sample.end(), less);
+
+    std::vector<std::vector<size_t>> cuts(parts + 1, std::vector<size_t>(k, 0));
+    cuts[parts] = lengths;
+    for (size_t r = 0; r < k; r++) {
+        File f(runs[r], "rb");
+        for (int p = 1; p < parts; p++) {
+            const T splitter = sample[sample.size() * p / parts];
+            size_t lo = cuts[p - 1][r], hi = lengths[r];
+            while (lo < hi) {
+                size_t mid = lo + (hi - lo) / 2;
+                if (less(readAt<T>(f.f, mid), splitter)) lo = mid + 1;
+                else hi = mid;
+            }
+            cuts[p][r] = lo;
+        }
+    }
+    return cuts;
+}
+
+} // namespace external_detail
+
+// Sorts the T values in `input` into `output`.
+//  1. Run formation: chunks of memoryBytes / (2 sizeof(T)) elements are read
+//     with one large fread each, sorted by sortChunk(data, n) (which may use
+//     as much scratch as the chunk itself) and written out as runs.
+//  2. Merge passes: each merge splits the chunk buffer into k + 1 blocks, one
+//     per run being read and one for the output, and a loser tree picks the
+//     next element. If blocks would fall under minBlockBytes, groups of runs
+//     are merged into longer runs first.
+//  3. The final pass is split by key range: one merge per thread, each
+//     reading its slice of every run (see splitRuns) and writing its own
+//     region of the output, with a share of the buffer.
+// All I/O is large sequential fread/fwrite blocks, so it streams at disk
+// bandwidth without mmap (whose resident pages would not count against the
+// budget). Throws std::runtime_error on I/O failure; temporary runs are
+// removed as soon as they have been merged, and on every exit path. The
+// output is written under a temporary name in its own directory and renamed
+// over `output` only once complete, so a failed sort leaves an existing
+// output file as it was.
+template <typename T, typename Less, typename SortChunk>
+ExternalSortStats externalSort(const std::string& input, const std::string& output, const ExternalSortOptions& options,
+                               Less less, SortChunk sortChunk) {
+    using namespace external_detail;
+    auto begin = std::chrono::steady_clock::now();
+    ExternalSortStats stats;
+    std::ostream* log = options.progress;
+
+    const size_t inputBytes = fileSize(input);
+    if (inputBytes % sizeof(T) != 0) throw std::runtime_error(input + ": size is not a whole number of keys");
+    stats.elements = inputBytes / sizeof(T);
+    const size_t chunkElements = std::max<size_t>(1, options.memoryBytes / (2 * sizeof(T)));
+    const size_t totalRuns = std::max<size_t>(1, (stats.elements + chunkElements - 1) / chunkElements);
+    std::vector<T> memory(std::min(chunkElements, std::max<size_t>(stats.elements, 1)));
+    RunSet runSet(options.tempDir);
+
+    // 1. Run formation
+    std::vector<std::string> runs;
+    std::vector<size_t> lengths;
+    {
+        File in(input, "rb");
+        for (size_t r = 0; r < totalRuns; r++) {
+            auto start = std::chrono::steady_clock::now();
+            const size_t n = std::fread(memory.data(), sizeof(T), memory.size(), in.f);
+            const double readTime = seconds(start);
+            if (n == 0 && r > 0) break;
+
+            start = std::chrono::steady_clock::now();
+            sortChunk(memory.data(), n);
+            const double sortTime = seconds(start);
+
+            start = std::chrono::steady_clock::now();
+            runs.push_back(runSet.create(0, r));
+            lengths.push_back(n);
+            {
+                File out(runs.back(), "wb");
+                if (std::fwrite(memory.data(), sizeof(T), n, out.f) != n)
+                    throw std::runtime_error("short write to " + runs.back());
+            }
+            const double writeTime = seconds(start);
+
+            stats.bytesRead += n * sizeof(T);
+            stats.bytesWritten += n * sizeof(T);
+            stats.readSeconds += readTime;
+            stats.sortSeconds += sortTime;
+            stats.writeSeconds += writeTime;
+            if (log) {
+                *log << std::fixed << std::setprecision(1) << "run " << r + 1 << "/" << totalRuns << ": "
+                     << n * sizeof(T) / 1048576.0 << " MB, read " << mbPerSecond(n * sizeof(T), readTime)
+                     << " MB/s, sorted in " << std::setprecision(3) << sortTime << " s, written "
+                     << std::setprecision(1) << mbPerSecond(n * sizeof(T), writeTime) << " MB/s\n";
+            }
+        }
+    }
+    stats.runs = runs.size();
+
+    // Input that fit in one chunk is renamed into place if the file system allows
+    auto mergeStart = std::chrono::steady_clock::now();
+    if (runs.size() == 1 && replaceFile(runs[0], output)) {
+        runSet.release(runs[0]);
+        stats.totalSeconds = seconds(begin);
+        return stats;
+    }
+
+    // 2. Intermediate passes while there are more runs than one merge can take
+    const size_t maxFanIn = std::max<size_t>(2, memory.size() * sizeof(T) / options.minBlockBytes - 1);
+    auto noProgress = [](size_t) {};
+    while (runs.size() > maxFanIn) {
+        stats.mergePasses++;
+        std::vector<std::string> next;
+        std::vector<size_t> nextLengths;
+        for (size_t g = 0; g < runs.size(); g += maxFanIn) {
+            const size_t k = std::min(maxFanIn, runs.size() - g);
+            std::vector<std::string> group(runs.begin() + g, runs.begin() + g + k);
+            std::vector<size_t> from(k, 0), to(lengths.begin() + g, lengths.begin() + g + k);
+            next.push_back(runSet.create(stats.mergePasses, next.size()));
+            {
+                File out(next.back(), "wb");
+                IOCounters io = mergeToFile(group, from, to, out.f, memory.data(), memory.size(), less, noProgress);
+                stats.bytesRead += io.bytesRead;
+                stats.bytesWritten += io.bytesWritten;
+                stats.readSeconds += io.readSeconds;
+                stats.writeSeconds += io.writeSeconds;
+                nextLengths.push_back(io.bytesWritten / sizeof(T));
+            }
+            auto cleanup = std::chrono::steady_clock::now();
+            for (const std::string& run : group) runSet.remove(run);
+            stats.cleanupSeconds += seconds(cleanup);
+        }
+        if (log) *log << "merge pass " << stats.mergePasses << ": " << runs.size() << " runs -> " << next.size() << "\n";
+        runs.swap(next);
+        lengths.swap(nextLengths);
+    }
+
+    // 3. Final pass, one key range per thread (fewer if blocks would get too small)
+    stats.mergePasses++;
+    const size_t blocksPerPart = runs.size() + 1;
+    const int parts = (int)std::max<size_t>(
+        1, std::min({(size_t)omp_get_max_threads(), stats.elements >> 20,
+                     memory.size() * sizeof(T) / (options.minBlockBytes * blocksPerPart)}));
+    const size_t partElements = memory.size() / parts;
+    std::vector<std::vector<size_t>> cuts = splitRuns<T>(runs, lengths, parts, less);
+    const std::string merged = runSet.createBeside(output);
+    { File create(merged, "wb"); }
+    size_t written = 0, nextReport = stats.elements / 10;
+    std::string error;
+    IOCounters total;
+    #pragma omp parallel for schedule(static, 1) num_threads(parts)
+    for (int p = 0; p < parts; p++) {
+        try {
+            size_t offset = 0;
+            for (size_t r = 0; r < runs.size(); r++) offset += cuts[p][r];
+            File out(merged, "r+b");
+            seekTo(out.f, offset * sizeof(T));
+            auto report = [&](size_t elements) {
+                #pragma omp critical(external_sort_progress)
+                {
+                    written += elements;
+                    if (log && written >= nextReport && nextReport > 0) {
+                        *log << "merge pass " << stats.mergePasses << ": " << std::setprecision(0)
+                             << 100.0 * written / stats.elements << "% of " << runs.size() << " runs, "
+                             << std::setprecision(1) << mbPerSecond(written * sizeof(T), seconds(mergeStart))
+                             << " MB/s\n";
+                        while (nextReport <= written) nextReport += stats.elements / 10;
+                    }
+                }
+            };
+            IOCounters io = mergeToFile(runs, cuts[p], cuts[p + 1], out.f, memory.data() + p * partElements,
+                                        partElements, less, report);
+            #pragma omp critical(external_sort_progress)
+            total.add(io);
+        } catch (const std::exception& e) {
+            #pragma omp critical(external_sort_progress)
+            error = e.what();
+        }
+    }
+    if (!error.empty()) throw std::runtime_error(output + ": " + error);
+    if (!replaceFile(merged, output)) throw std::runtime_error("cannot rename " + merged + " to " + output);
+    runSet.release(merged);
+    auto cleanup = std::chrono::steady_clock::now();
+    for (const std::string& run : runs) runSet.remove(run);
+    stats.cleanupSeconds += seconds(cleanup);
+    if (log) *log << "merge pass " << stats.mergePasses << ": " << runs.size() << " runs -> 1 (" << parts << " key ranges)\n";
+
+    stats.bytesRead += total.bytesRead;
+    stats.bytesWritten += total.bytesWritten;
+    stats.readSeconds += total.readSeconds;
+    stats.writeSeconds += total.writeSeconds;
+    stats.mergeSeconds = seconds(mergeStart) - stats.cleanupSeconds;
+    stats.totalSeconds = seconds(begin);
+    return stats;
+}
+
+// Sorts each chunk with the ping-pong merge sort, its arena reused across chunks
+template <typename T, typename Less = std::less<T>>
+ExternalSortStats externalSort(const std::string& input, const std::string& output, const ExternalSortOptions& options,
+                               Less less = Less()) {
+    MergeSortArena<T> arena;
+    return externalSort<T>(input, output, options, less,
+                           [&](T* data, size_t n) { pingPongMergeSort(data, n, arena, less); });
+}
@@ -0,0 +1,278 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <algorithm>
+#include <omp.h>
+#include <queue>
+#include <stack>
+#include <random>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include "csr_graph.h"
+#include "bfs.h"
+#include "dfs.h"
+#include "graph_io.h"
+#include "graph_generators.h"
+
+using namespace std;
+
+// Traversal benchmark: generates synthetic graphs over a range of scales and
+// runs every BFS/DFS engine at every thread count from the same random roots.
+// Results use the Graph500 metric, traversed edges per second (TEPS): the
+// input edges inside the root's component divided by the traversal time,
+// combined over roots with a harmonic mean.
+
+struct BenchmarkOptions {
+    string generator = "rmat";
+    int minScale = 10, maxScale = 16;
+    int edgeFactor = 16;
+    int roots = 8;
+    uint64_t seed = 1;
+    vector<int> threads;
+    string csvFile = "traversal_benchmark.csv";
+    string levelCsvFile = "traversal_levels.csv";
+    string saveBinary; // Write the largest generated graph as a binary edge list
+};
+
+// One timed traversal of one engine from one root
+struct RunStats {
+    double ms = 0;
+    int64_t reached = 0;
+    bool valid = true;
+    vector<BFSLevelStats> levels;
+};
+
+// Sequential BFS baseline (queue), same as parallel_bfs.cpp
+RunStats sequentialBFS(const CSRGraph<>& g, int start, vector<int32_t>& level) {
+    RunStats stats;
+    double t0 = omp_get_wtime();
+    level.assign(g.numVertices(), -1);
+    queue<int> q;
+    q.push(start);
+    level[start] = 0;
+    while (!q.empty()) {
+        int node = q.front();
+        q.pop();
+        stats.reached++;
+        for (int next_node : g.neighbors(node)) {
+            if (level[next_node] < 0) {
+                level[next_node] = level[node] + 1;
+                q.push(next_node);
+            }
+        }
+    }
+    stats.ms = (omp_get_wtime() - t0) * 1000.0;
+    return stats;
+}
+
+// Sequential DFS baseline (explicit stack), same as parallel_dfs.cpp
+RunStats sequentialDFS(const CSRGraph<>& g, int start) {
+    RunStats stats;
+    double t0 = omp_get_wtime();
+    vector<char> visited(g.numVertices(), 0);
+    stack<int> s;
+    s.push(start);
+    while (!s.empty()) {
+        int node = s.top();
+        s.pop();
+        if (visited[node]) continue;
+        visited[node] = 1;
+        stats.reached++;
+        auto nbrs = g.neighbors(node);
+        for (const int* it = nbrs.end(); it != nbrs.begin();) {
+            int next_node = *--it;
+            if (!visited[next_node]) s.push(next_node);
+        }
+    }
+    stats.ms = (omp_get_wtime() - t0) * 1000.0;
+    return stats;
+}
+
+RunStats runEngine(const string& engine, const CSRGraph<>& g, int root) {
+    RunStats stats;
+    double t0 = omp_get_wtime();
+    if (engine == "frontier-bfs") {
+        BFSResult<int> r = frontierBFS(g, root);
+        stats.ms = (omp_get_wtime() - t0) * 1000.0;
+        stats.reached = r.reached;
+        stats.valid = validateBFSTree(g, root, r);
+        stats.levels = move(r.levels);
+    } else if (engine == "hybrid-bfs") {
+        BFSResult<int> r = hybridBFS(g, root);
+        stats.ms = (omp_get_wtime() - t0) * 1000.0;
+        stats.reached = r.reached;
+        stats.valid = validateBFSTree(g, root, r);
+        stats.levels = move(r.levels);
+    } else {
+        DFSResult<int> r = workStealingDFS(g, root);
+        stats.ms = (omp_get_wtime() - t0) * 1000.0;
+        stats.reached = r.reached;
+        stats.valid = validateDFSForest(g, r);
+    }
+    return stats;
+}
+
+// Parses "1,2,4,8" into a list of positive integers
+bool parseIntList(const char* text, vector<int>& out) {
+    out.clear();
+    stringstream ss(text);
+    string item;
+    while (getline(ss, item, ',')) {
+        int value = atoi(item.c_str());
+        if (value < 1) return false;
+        out.push_back(value);
+    }
+    return !out.empty();
+}
+
+bool parseBenchmarkOptions(int argc, char* argv[], BenchmarkOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc) return false;
+        if (strcmp(argv[i], "--generator") == 0) options.generator = argv[++i];
+        else if (strcmp(argv[i], "--scale") == 0) {
+            const char* text = argv[++i];
+            const char* dash = strchr(text, '-');
+            options.minScale = atoi(text);
+            options.maxScale = dash ? atoi(dash + 1) : options.minScale;
+        } else if (strcmp(argv[i], "--edge-factor") == 0) options.edgeFactor = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--roots") == 0) options.roots = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--seed") == 0) options.seed = strtoull(argv[++i], nullptr, 10);
+        else if (strcmp(argv[i], "--threads") == 0) {
+            if (!parseIntList(argv[++i], options.threads)) return false;
+        } else if (strcmp(argv[i], "--csv") == 0) options.csvFile = argv[++i];
+        else if (strcmp(argv[i], "--level-csv") == 0) options.levelCsvFile = argv[++i];
+        else if (strcmp(argv[i], "--save-binary") == 0) options.saveBinary = argv[++i];
+        else return false;
+    }
+    return options.minScale >= 1 && options.minScale <= options.maxScale && options.maxScale <= 30 &&
+           options.edgeFactor >= 1 && options.roots >= 1;
+}
+
+int main(int argc, char* argv[]) {
+    BenchmarkOptions options;
+    if (!parseBenchmarkOptions(argc, argv, options)) {
+        cout << "Usage: " << argv[0] << " [--generator rmat|er|grid2d|grid3d|path|tree] [--scale min-max]"
+             << " [--edge-factor k] [--roots r] [--threads 1,2,4,...] [--seed s]"
+             << " [--csv out.csv] [--level-csv levels.csv] [--save-binary out.bin]\n";
+        return 1;
+    }
+    if (options.threads.empty()) {
+        for (int t = 1; t < omp_get_max_threads(); t *= 2) options.threads.push_back(t);
+        options.threads.push_back(omp_get_max_threads());
+    }
+
+    ofstream csv(options.csvFile), levelCsv(options.levelCsvFile);
+    if (!csv || !levelCsv) {
+        cout << "Cannot open " << options.csvFile << " or " << options.levelCsvFile << " for writing.\n";
+        return 1;
+    }
+    csv << "generator,scale,vertices,edges,engine,threads,roots,mean_ms,harmonic_teps,speedup,efficiency,valid\n";
+    levelCsv << "generator,scale,engine,threads,root,level,direction,frontier,edges_examined,ms\n";
+
+    const string engines[] = {"frontier-bfs", "hybrid-bfs", "ws-dfs"};
+    cout << fixed << setprecision(3);
+
+    for (int scale = options.minScale; scale <= options.maxScale; scale++) {
+        int n;
+        double t0 = omp_get_wtime();
+        vector<CSRGraph<>::Edge> edges;
+        try {
+            edges = generateGraph<int>(options.generator, scale, options.edgeFactor, options.seed, n);
+        } catch (const exception& e) {
+            cout << e.what() << "\n";
+            return 1;
+        }
+        double genTime = (omp_get_wtime() - t0) * 1000.0;
+        if (scale == options.maxScale && !options.saveBinary.empty()) saveBinaryEdgeList(options.saveBinary, edges);
+
+        CSRBuildOptions buildOptions;
+        buildOptions.removeSelfLoops = buildOptions.removeDuplicates = true;
+        CSRGraph<> graph = CSRGraph<>::fromEdgesParallel(n, edges, buildOptions);
+        edges = vector<CSRGraph<>::Edge>();
+        cout << "\n" << options.generator << " scale " << scale << ": " << n << " vertices, "
+             << graph.numArcs() / 2 << " edges (generated in " << genTime << " ms)\n";
+
+        // Roots with at least one edge, as in Graph500
+        vector<int> roots;
+        mt19937 rng(options.seed + scale);
+        uniform_int_distribution<int> pick(0, n - 1);
+        for (int tries = 0; (int)roots.size() < options.roots && tries < 100 * options.roots; tries++) {
+            int v = pick(rng);
+            if (graph.degree(v) > 0) roots.push_back(v);
+        }
+        if (roots.empty()) roots.push_back(0);
+
+        // Component sizes (in input edges) from the sequential BFS levels
+        vector<int64_t> componentEdges(roots.size());
+        double seqBfsMs = 0, seqDfsMs = 0, seqBfsInvTeps = 0, seqDfsInvTeps = 0;
+        vector<int32_t> level;
+        for (size_t r = 0; r < roots.size(); r++) {
+            RunStats s = sequentialBFS(graph, roots[r], level);
+            int64_t arcs = 0;
+            for (int v = 0; v < n; v++) {
+                if (level[v] >= 0) arcs += graph.degree(v);
+            }
+            componentEdges[r] = max<int64_t>(arcs / 2, 1);
+            seqBfsMs += s.ms;
+            seqBfsInvTeps += s.ms / 1000.0 / componentEdges[r];
+            RunStats d = sequentialDFS(graph, roots[r]);
+            seqDfsMs += d.ms;
+            seqDfsInvTeps += d.ms / 1000.0 / componentEdges[r];
+        }
+        const int R = roots.size();
+        seqBfsMs /= R;
+        seqDfsMs /= R;
+
+        auto report = [&](const string& engine, int threads, double meanMs, double invTeps, double baseMs, bool valid) {
+            double teps = R / invTeps;
+            double speedup = baseMs / meanMs;
+            csv << options.generator << "," << scale << "," << n << "," << graph.numArcs() / 2 << "," << engine << ","
+                << threads << "," << R << "," << meanMs << "," << teps << "," << speedup << ","
+                << speedup / threads << "," << (valid ? 1 : 0) << "\n";
+            cout << "  " << setw(12) << engine << "  threads " << setw(3) << threads << "  " << setw(10) << meanMs
+                 << " ms  " << setw(10) << teps / 1e6 << " MTEPS  speedup " << setw(7) << speedup
+                 << "  efficiency " << setw(6) << speedup / threads << (valid ? "" : "  INVALID") << "\n";
+        };
+        report("seq-bfs", 1, seqBfsMs, seqBfsInvTeps, seqBfsMs, true);
+        report("seq-dfs", 1, seqDfsMs, seqDfsInvTeps, seqDfsMs, true);
+
+        for (const string& engine : engines) {
+            const double baseMs = engine == "ws-dfs" ? seqDfsMs : seqBfsMs;
+            for (int threads : options.threads) {
+                omp_set_num_threads(threads);
+                double meanMs = 0, invTeps = 0;
+                bool valid = true;
+                for (int r = 0; r < R; r++) {
+                    RunStats s = runEngine(engine, graph, roots[r]);
+                    meanMs += s.ms;
+                    invTeps += s.ms / 1000.0 / componentEdges[r];
+                    valid = valid && s.valid;
+                    for (const BFSLevelStats& lvl : s.levels) {
+                        levelCsv << options.generator << "," << scale << "," << engine << "," << threads << ","
+                                 << r << "," << lvl.level << "," << directionName(lvl.direction) << ","
+                                 << lvl.frontierVertices << "," << lvl.edgesExamined << "," << lvl.ms << "\n";
+                    }
+                }
+                report(engine, threads, meanMs / R, invTeps, baseMs, valid);
+            }
+        }
+    }
+
+    cout << "\nResults written to " << options.csvFile << " and " << options.levelCsvFile << "\n";
+    return 0;
+}
+
+/*$ ./graph_benchmark.exe --generator rmat --scale 16 --threads 1 --roots 4
+
+rmat scale 16: 65536 vertices, 909499 edges (generated in 85.919 ms)
+       seq-bfs  threads   1       2.338 ms     389.080 MTEPS  speedup   1.000  efficiency  1.000
+       seq-dfs  threads   1       5.529 ms     164.503 MTEPS  speedup   1.000  efficiency  1.000
+  frontier-bfs  threads   1       2.583 ms     352.150 MTEPS  speedup   0.905  efficiency  0.905
+    hybrid-bfs  threads   1       1.283 ms     708.825 MTEPS  speedup   1.822  efficiency  1.822
+        ws-dfs  threads   1      20.106 ms      45.235 MTEPS  speedup   0.275  efficiency  0.275
+
+Results written to traversal_benchmark.csv and traversal_levels.csv
+*/
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include <omp.h>
+
+// Synthetic graphs for benchmarking, returned as edge lists for
+// CSRGraph::fromEdgesParallel. Every edge is drawn from a counter-based
+// generator keyed by (seed, edge index), so the output does not depend on
+// the thread count and the edges are filled in one parallel loop.
+
+namespace generator_detail {
+
+inline uint64_t splitmix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// Small per-edge stream: state starts from the hashed edge index
+struct EdgeRandom {
+    uint64_t state;
+    EdgeRandom(uint64_t seed, uint64_t index) : state(splitmix64(seed ^ splitmix64(index))) {}
+    uint64_t next() { return state = splitmix64(state); }
+    double uniform() { return (next() >> 11) * (1.0 / 9007199254740992.0); }
+};
+
+// Random relabelling, as Graph500 does, so vertex ids carry no locality
+template <typename VertexT>
+void scrambleIds(std::vector<std::pair<VertexT, VertexT>>& edges, VertexT n, uint64_t seed) {
+    std::vector<VertexT> perm(n);
+    std::iota(perm.begin(), perm.end(), VertexT(0));
+    std::shuffle(perm.begin(), perm.end(), std::mt19937_64(seed));
+    #pragma omp parallel for schedule(static)
+    for (int64_t i = 0; i < (int64_t)edges.size(); i++) {
+        edges[i].first = perm[edges[i].first];
+        edges[i].second = perm[edges[i].second];
+    }
+}
+
+} // namespace generator_detail
+
+// Quadrant probabilities for R-MAT; the defaults are the Graph500 ones
+struct RMATParams {
+    double a = 0.57, b = 0.19, c = 0.19; // d = 1 - a - b - c
+    bool scramble = true;
+};
+
+// R-MAT / Kronecker graph with 2^scale vertices and edgeFactor * 2^scale
+// edges: each edge picks one quadrant of the adjacency matrix per bit
+template <typename VertexT>
+std::vector<std::pair<VertexT, VertexT>> rmatEdges(int scale, int edgeFactor, uint64_t seed = 1,
+                                                   const RMATParams& params = RMATParams()) {
+    const VertexT n = VertexT(1) << scale;
+    const int64_t m = (int64_t)edgeFactor * n;
+    const double ab = params.a + params.b;
+    const double aOverAB = params.a / ab;
+    const double cOverCD = params.c / (1.0 - ab);
+    std::vector<std::pair<VertexT, VertexT>> edges(m);
+
+    #pragma omp parallel for schedule(static)
+    for (int64_t i = 0; i < m; i++) {
+        generator_detail::EdgeRandom rng(seed, (uint64_t)i);
+        VertexT u = 0, v = 0;
+        for (int bit = 0; bit < scale; bit++) {
+            bool lower = rng.uniform() > ab;
+            bool right = rng.uniform() > (lower ? cOverCD : aOverAB);
+            u |= (VertexT)lower << bit;
+            v |= (VertexT)right << bit;
+        }
+        edges[i] = {u, v};
+    }
+    if (params.scramble) generator_detail::scrambleIds(edges, n, seed);
+    return edges;
+}
+
+// Erdős–Rényi G(n, m): m edges with independent uniform endpoints
+template <typename VertexT>
+std::vector<std::pair<VertexT, VertexT>> erdosRenyiEdges(VertexT n, int64_t m, uint64_t seed = 1) {
+    std::vector<std::pair<VertexT, VertexT>> edges(m);
+    #pragma omp parallel for schedule(static)
+    for (int64_t i = 0; i < m; i++) {
+        generator_detail::EdgeRandom rng(seed, (uint64_t)i);
+        edges[i] = {(VertexT)(rng.next() % (uint64_t)n), (VertexT)(rng.next() % (uint64_t)n)};
+    }
+    return edges;
+}
+
+// rows x cols grid; vertex (r, c) is r * cols + c and links right and down
+template <typename VertexT>
+std::vector<std::pair<VertexT, VertexT>> grid2DEdges(VertexT rows, VertexT cols) {
+    const int64_t horizontal = (int64_t)rows * (cols - 1);
+    std::vector<std::pair<VertexT, VertexT>> edges(horizontal + (int64_t)(rows - 1) * cols);
+    #pragma omp parallel for schedule(static)
+    for (int64_t r = 0; r < (int64_t)rows; r++) {
+        for (int64_t c = 0; c < (int64_t)cols; c++) {
+            VertexT v = (VertexT)(r * cols + c);
+            if (c + 1 < cols) edges[r * (cols - 1) + c] = {v, v + 1};
+            if (r + 1 < rows) edges[horizontal + r * cols + c] = {v, (VertexT)(v + cols)};
+        }
+    }
+    return edges;
+}
+
+// x * y * z grid with 6-neighbour connectivity
+template <typename VertexT>
+std::vector<std::pair<VertexT, VertexT>> grid3DEdges(VertexT x, VertexT y, VertexT z) {
+    const int64_t n = (int64_t)x * y * z;
+    std::vector<int64_t> count(n + 1, 0);
+    auto forEachEdge = [&](int64_t v, auto emit) {
+        int64_t i = v % x, j = (v / x) % y, k = v / ((int64_t)x * y);
+        if (i + 1 < x) emit(v + 1);
+        if (j + 1 < y) emit(v + x);
+        if (k + 1 < z) emit(v + (int64_t)x * y);
+    };
+    #pragma omp parallel for schedule(static)
+    for (int64_t v = 0; v < n; v++) forEachEdge(v, [&](int64_t) { count[v + 1]++; });
+    for (int64_t v = 0; v < n; v++) count[v + 1] += count[v];
+
+    std::vector<std::pair<VertexT, VertexT>> edges(count[n]);
+    #pragma omp parallel for schedule(static)
+    for (int64_t v = 0; v < n; v++) {
+        int64_t out = count[v];
+        forEachEdge(v, [&](int64_t w) { edges[out++] = {(VertexT)v, (VertexT)w}; });
+    }
+    return edges;
+}
+
+// Path 0 - 1 - ... - (n - 1): worst case for level-synchronous BFS
+template <typename VertexT>
+std::vector<std::pair<VertexT, VertexT>> pathEdges(VertexT n) {
+    std::vector<std::pair<VertexT, VertexT>> edges(n > 0 ? n - 1 : 0);
+    #pragma omp parallel for schedule(static)
+    for (int64_t v = 0; v < (int64_t)edges.size(); v++) edges[v] = {(VertexT)v, (VertexT)(v + 1)};
+    return edges;
+}
+
+// Random recursive tree: vertex i > 0 hangs off a uniform earlier vertex,
+// so the expected depth is O(log n) and subtrees vary widely in size
+template <typename VertexT>
+std::vector<std::pair<VertexT, VertexT>> randomTreeEdges(VertexT n, uint64_t seed = 1) {
+    std::vector<std::pair<VertexT, VertexT>> edges(n > 0 ? n - 1 : 0);
+    #pragma omp parallel for schedule(static)
+    for (int64_t v = 1; v < (int64_t)n; v++) {
+        generator_detail::EdgeRandom rng(seed, (uint64_t)v);
+        edges[v - 1] = {(VertexT)(rng.next() % (uint64_t)v), (VertexT)v};
+    }
+    return edges;
+}
+
+// Uniform integer weights in [1, maxWeight], one per edge index, for the
+// weighted graphs built with WeightedCSRGraph::fromEdgesParallel
+template <typename WeightT>
+std::vector<WeightT> randomWeights(int64_t m, WeightT maxWeight, uint64_t seed = 1) {
+    std::vector<WeightT> weights(m);
+    #pragma omp parallel for schedule(static)
+    for (int64_t i = 0; i < m; i++) {
+        generator_detail::EdgeRandom rng(~seed, (uint64_t)i);
+        weights[i] = (WeightT)(1 + rng.next() % (uint64_t)maxWeight);
+    }
+    return weights;
+}
+
+// Generator by name, sized so every kind has 2^scale vertices (grids split the
+// bits across their dimensions). Sets n and returns the edges.
+template <typename VertexT>
+std::vector<std::pair<VertexT, VertexT>> generateGraph(const std::string& kind, int scale, int edgeFactor,
+                                                       uint64_t seed, VertexT& n) {
+    if (scale < 1 || scale > (int)sizeof(VertexT) * 8 - 2) throw std::invalid_argument("scale out of range");
+    n = VertexT(1) << scale;
+    if (kind == "rmat") return rmatEdges<VertexT>(scale, edgeFactor, seed);
+    if (kind == "er") return erdosRenyiEdges<VertexT>(n, (int64_t)edgeFactor * n, seed);
+    if (kind == "grid2d") return grid2DEdges<VertexT>(VertexT(1) << (scale / 2), VertexT(1) << (scale - scale / 2));
+    if (kind == "grid3d") {
+        int bx = scale / 3, by = (scale - bx) / 2, bz = scale - bx - by;
+        return grid3DEdges<VertexT>(VertexT(1) << bx, VertexT(1) << by, VertexT(1) << bz);
+    }
+    if (kind == "path") return pathEdges<VertexT>(n);
+    if (kind == "tree") return randomTreeEdges<VertexT>(n, seed);
+    throw std::invalid_argument("unknown generator '" + kind + "' (expected rmat, er, grid2d, grid3d, path or tree)");
+}
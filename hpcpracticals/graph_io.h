@@ -0,0 +1,321 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include <omp.h>
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Graph file loading without per-edge `cin >> u >> v`.
+// Supported formats:
+//   *.bin  raw (u, v) pairs of VertexT in native byte order, memory-mapped
+//   *.mtx  Matrix Market coordinate files (1-based ids, extra columns ignored)
+//   other  SNAP-style text edge lists (0-based ids, '#' comment lines)
+// Text files are split into one chunk per thread at line boundaries and
+// parsed in parallel with a hand-written integer scanner.
+
+template <typename VertexT>
+struct EdgeListFile {
+    VertexT numVertices = 0;
+    int base = 0; // Id of the first vertex as written in the file (1 for Matrix Market)
+    std::vector<std::pair<VertexT, VertexT>> edges;
+};
+
+// Read-only view of a whole file: mmap on POSIX, a plain read elsewhere
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+#ifdef _WIN32
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in) throw std::runtime_error("cannot open " + path);
+        buffer.resize((size_t)in.tellg());
+        in.seekg(0);
+        in.read(buffer.data(), buffer.size());
+        ptr = buffer.data();
+        length = buffer.size();
+#else
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("cannot open " + path);
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            close(fd);
+            throw std::runtime_error("cannot stat " + path);
+        }
+        length = (size_t)st.st_size;
+        if (length > 0) {
+            void* addr = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr == MAP_FAILED) {
+                close(fd);
+                throw std::runtime_error("cannot mmap " + path);
+            }
+            madvise(addr, length, MADV_SEQUENTIAL);
+            ptr = static_cast<const char*>(addr);
+        }
+        close(fd);
+#endif
+    }
+
+    ~MappedFile() {
+#ifndef _WIN32
+        if (ptr) munmap(const_cast<char*>(ptr), length);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return ptr; }
+    size_t size() const { return length; }
+
+private:
+#ifdef _WIN32
+    std::vector<char> buffer;
+#endif
+    const char* ptr = nullptr;
+    size_t length = 0;
+};
+
+namespace graph_io_detail {
+
+inline bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+inline const char* skipLine(const char* p, const char* end) {
+    while (p < end && *p != '\n') p++;
+    return p < end ? p + 1 : end;
+}
+
+// Parses an unsigned decimal at p; returns false if none is present or it
+// does not fit in 64 bits
+inline bool parseUnsigned(const char*& p, const char* end, uint64_t& value) {
+    while (p < end && isSpace(*p)) p++;
+    if (p == end || *p < '0' || *p > '9') return false;
+    uint64_t x = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        uint64_t d = (uint64_t)(*p++ - '0');
+        if (x > (UINT64_MAX - d) / 10) return false;
+        x = x * 10 + d;
+    }
+    value = x;
+    return true;
+}
+
+// Parses edge lines in [begin, end) in parallel; ids are shifted down by base
+template <typename VertexT>
+void parseEdgeLines(const char* begin, const char* end, int base, EdgeListFile<VertexT>& out) {
+    const int maxThreads = omp_get_max_threads();
+    const size_t total = end - begin;
+    std::vector<std::vector<std::pair<VertexT, VertexT>>> local(maxThreads);
+    std::vector<size_t> offsets(maxThreads + 1, 0);
+    uint64_t maxId = 0;
+    bool bad = false;
+
+    #pragma omp parallel reduction(max:maxId) reduction(||:bad)
+    {
+        const int tid = omp_get_thread_num();
+        const int nt = omp_get_num_threads();
+        // Each chunk owns the lines that start inside it
+        const char* p = begin + total * tid / nt;
+        const char* stop = begin + total * (tid + 1) / nt;
+        if (p > begin && p[-1] != '\n') p = skipLine(p, end);
+
+        std::vector<std::pair<VertexT, VertexT>>& edges = local[tid];
+        edges.reserve((stop - p) / 8);
+        while (p < stop) {
+            const char* line = p;
+            while (line < end && isSpace(*line)) line++;
+            if (line == end || *line == '\n' || *line == '#' || *line == '%') {
+                p = skipLine(line, end);
+                continue;
+            }
+            uint64_t u, v;
+            const char* q = line;
+            if (!parseUnsigned(q, end, u) || !parseUnsigned(q, end, v) || u < (uint64_t)base || v < (uint64_t)base) {
+                bad = true;
+                p = skipLine(q, end);
+                continue;
+            }
+            u -= base;
+            v -= base;
+            maxId = std::max(maxId, std::max(u, v));
+            edges.emplace_back((VertexT)u, (VertexT)v);
+            p = skipLine(q, end);
+        }
+        offsets[tid + 1] = edges.size();
+
+        #pragma omp barrier
+        #pragma omp single
+        {
+            for (int t = 0; t < nt; t++) offsets[t + 1] += offsets[t];
+            out.edges.resize(offsets[nt]);
+        }
+        std::copy(edges.begin(), edges.end(), out.edges.begin() + offsets[tid]);
+        std::vector<std::pair<VertexT, VertexT>>().swap(edges);
+    }
+
+    if (bad) throw std::runtime_error("malformed edge line");
+    if (!out.edges.empty()) {
+        if (maxId >= (uint64_t)std::numeric_limits<VertexT>::max()) {
+            throw std::runtime_error("vertex id does not fit the vertex type");
+        }
+        out.numVertices = std::max(out.numVertices, (VertexT)(maxId + 1));
+    }
+}
+
+inline bool endsWith(const std::string& s, const std::string& suffix) {
+    return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+} // namespace graph_io_detail
+
+// Raw (u, v) pairs of VertexT; the mapping is copied straight into the edge array
+template <typename VertexT>
+EdgeListFile<VertexT> loadBinaryEdgeList(const std::string& path) {
+    static_assert(sizeof(std::pair<VertexT, VertexT>) == 2 * sizeof(VertexT), "edge pairs must be packed");
+    MappedFile file(path);
+    if (file.size() % (2 * sizeof(VertexT)) != 0) {
+        throw std::runtime_error(path + ": size is not a whole number of edges");
+    }
+    EdgeListFile<VertexT> out;
+    const int64_t m = file.size() / (2 * sizeof(VertexT));
+    out.edges.resize(m);
+    const VertexT* ids = reinterpret_cast<const VertexT*>(file.data());
+    VertexT maxId = -1;
+    bool bad = false;
+
+    #pragma omp parallel for schedule(static) reduction(max:maxId) reduction(||:bad)
+    for (int64_t i = 0; i < m; i++) {
+        VertexT u = ids[2 * i], v = ids[2 * i + 1];
+        bad = bad || u < 0 || v < 0;
+        maxId = std::max(maxId, std::max(u, v));
+        out.edges[i] = {u, v};
+    }
+    if (bad) throw std::runtime_error(path + ": negative vertex id");
+    out.numVertices = maxId + 1;
+    return out;
+}
+
+template <typename VertexT>
+void saveBinaryEdgeList(const std::string& path, const std::vector<std::pair<VertexT, VertexT>>& edges) {
+    FILE* f = fopen(path.c_str(), "wb");
+    if (!f) throw std::runtime_error("cannot create " + path);
+    size_t written = fwrite(edges.data(), sizeof(edges[0]), edges.size(), f);
+    fclose(f);
+    if (written != edges.size()) throw std::runtime_error("short write to " + path);
+}
+
+// SNAP edge list, or Matrix Market if the file starts with the %%MatrixMarket banner
+template <typename VertexT>
+EdgeListFile<VertexT> loadTextEdgeList(const std::string& path) {
+    using namespace graph_io_detail;
+    MappedFile file(path);
+    const char* p = file.data();
+    const char* end = p + file.size();
+    EdgeListFile<VertexT> out;
+
+    if (file.size() >= 14 && std::strncmp(p, "%%MatrixMarket", 14) == 0) {
+        out.base = 1;
+        while (p < end && *p == '%') p = skipLine(p, end);
+        uint64_t rows, cols, nnz;
+        if (!parseUnsigned(p, end, rows) || !parseUnsigned(p, end, cols) || !parseUnsigned(p, end, nnz)) {
+            throw std::runtime_error(path + ": missing Matrix Market size line");
+        }
+        if (std::max(rows, cols) > (uint64_t)std::numeric_limits<VertexT>::max()) {
+            throw std::runtime_error(path + ": Matrix Market size does not fit the vertex type");
+        }
+        out.numVertices = (VertexT)std::max(rows, cols);
+        p = skipLine(p, end);
+    }
+    parseEdgeLines(p, end, out.base, out);
+    return out;
+}
+
+// Picks the format from the file name
+template <typename VertexT>
+EdgeListFile<VertexT> loadEdgeListFile(const std::string& path) {
+    if (graph_io_detail::endsWith(path, ".bin")) return loadBinaryEdgeList<VertexT>(path);
+    return loadTextEdgeList<VertexT>(path);
+}
+
+// Command-line options shared by the graph driver programs:
+//   --graph <file> --source <s> --threads <t> [--load-only] [--dedup] [--save-binary <out.bin>]
+// The source is given in the file's own numbering (1-based for Matrix Market).
+struct GraphOptions {
+    std::string graphFile;
+    std::string saveBinary;
+    long long source = -1;
+    int threads = 0; // 0 = omp_get_max_threads()
+    bool loadOnly = false;
+    bool dedup = false; // Drop self-loops and parallel edges while building the CSR graph
+};
+
+// Consumes argv[i] (and its value) if it is a shared graph option
+inline bool parseGraphOption(int argc, char* argv[], int& i, GraphOptions& options) {
+    std::string flag = argv[i];
+    if (flag == "--load-only") {
+        options.loadOnly = true;
+        return true;
+    }
+    if (flag == "--dedup") {
+        options.dedup = true;
+        return true;
+    }
+    if (i + 1 >= argc) return false;
+    if (flag == "--graph") options.graphFile = argv[++i];
+    else if (flag == "--save-binary") options.saveBinary = argv[++i];
+    else if (flag == "--source") options.source = std::atoll(argv[++i]);
+    else if (flag == "--threads") options.threads = std::atoi(argv[++i]);
+    else return false;
+    return true;
+}
+
+// Loads options.graphFile and reports the load time separately from CSR construction.
+// --threads is applied before parsing, so it also sets the loader's team size.
+template <typename VertexT>
+bool loadGraphEdges(const GraphOptions& options, std::vector<std::pair<VertexT, VertexT>>& edges,
+                    VertexT& numVertices, int& base) {
+    if (options.threads > 0) omp_set_num_threads(options.threads);
+    double t0 = omp_get_wtime();
+    EdgeListFile<VertexT> file;
+    try {
+        file = loadEdgeListFile<VertexT>(options.graphFile);
+    } catch (const std::exception& e) {
+        std::cout << "Failed to load graph: " << e.what() << "\n";
+        return false;
+    }
+    double seconds = omp_get_wtime() - t0;
+    std::cout << "Loaded " << options.graphFile << ": " << file.numVertices << " vertices, "
+              << file.edges.size() << " edges\n";
+    std::cout << "Load Time: " << seconds * 1000.0 << " ms ("
+              << (seconds > 0 ? file.edges.size() / seconds / 1e6 : 0.0) << " M edges/s)\n";
+
+    if (!options.saveBinary.empty()) {
+        try {
+            saveBinaryEdgeList(options.saveBinary, file.edges);
+        } catch (const std::exception& e) {
+            std::cout << "Failed to save binary edge list: " << e.what() << "\n";
+            return false;
+        }
+        std::cout << "Saved 0-based binary edge list to " << options.saveBinary << "\n";
+    }
+
+    edges.swap(file.edges);
+    numVertices = file.numVertices;
+    base = file.base;
+    return true;
+}
@@ -0,0 +1,208 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <omp.h>
+#include "parallel_merge.h"
+
+// Adaptive (natural) merge sort: merges the runs already present in the
+// input instead of halving blindly, so sorted, reversed and nearly sorted
+// arrays take close to linear time. Stable.
+
+struct NaturalSortStats {
+    size_t runs = 0;           // Runs after detection and boundary joining
+    size_t reversed = 0;       // Strictly descending runs flipped in place
+    size_t merges = 0;         // Merges that moved data
+    size_t skippedMerges = 0;  // Merges whose runs were already in order
+    size_t mergedElements = 0; // Elements left to merge after trimming
+};
+
+namespace natural_detail {
+
+struct Run {
+    size_t lo, hi;
+};
+
+// Node of the merge tree: leaves are runs, inner nodes merge [lo, mid) and [mid, hi)
+struct Node {
+    size_t lo, mid, hi;
+    int left, right; // -1 for leaves
+};
+
+// Powersort node power of the boundary between runs [s1, e1) and [e1, e2):
+// the first bit where the runs' midpoints, as fractions of n, differ.
+// Boundaries with smaller power sit higher in the merge tree.
+inline int nodePower(size_t s1, size_t e1, size_t e2, size_t n) {
+    uint64_t l = s1 + e1, r = e1 + e2; // Twice the midpoints
+    const uint64_t twoN = 2 * (uint64_t)n;
+    for (int k = 1;; k++) {
+        l *= 2;
+        r *= 2;
+        const bool lUp = l >= twoN, rUp = r >= twoN;
+        if (lUp != rUp) return k;
+        if (lUp) {
+            l -= twoN;
+            r -= twoN;
+        }
+    }
+}
+
+// Extends the sorted prefix data[lo, sorted) to data[lo, hi) by binary insertion
+template <typename T, typename Less>
+void binaryInsertionSort(T* data, size_t lo, size_t sorted, size_t hi, Less less) {
+    for (size_t i = sorted; i < hi; i++) {
+        T x = data[i];
+        T* pos = std::upper_bound(data + lo, data + i, x, less);
+        std::move_backward(pos, data + i, data + i + 1);
+        *pos = x;
+    }
+}
+
+// Splits data[lo, hi) into runs: a non-descending run is kept, a strictly
+// descending one is reversed (strictness keeps equal keys in order), and
+// any run shorter than minRun is extended by binary insertion
+template <typename T, typename Less>
+void findRuns(T* data, size_t lo, size_t hi, size_t minRun, Less less, std::vector<Run>& runs, size_t& reversed) {
+    size_t i = lo;
+    while (i < hi) {
+        size_t j = i + 1;
+        if (j < hi && less(data[j], data[i])) {
+            while (j < hi && less(data[j], data[j - 1])) j++;
+            std::reverse(data + i, data + j);
+            reversed++;
+        } else {
+            while (j < hi && !less(data[j], data[j - 1])) j++;
+        }
+        if (j - i < minRun) {
+            const size_t end = std::min(hi, i + minRun);
+            binaryInsertionSort(data, i, j, end, less);
+            j = end;
+        }
+        runs.push_back({i, j});
+        i = j;
+    }
+}
+
+// Merges the adjacent sorted ranges data[lo, mid) and data[mid, hi). Keys of
+// the left run not above data[mid], and of the right run not below
+// data[mid - 1], are already in place, so only the overlap is merged
+// (through buffer) and copied back.
+template <typename T, typename Less>
+void mergeAdjacent(T* data, T* buffer, size_t lo, size_t mid, size_t hi, int slices, Less less,
+                   NaturalSortStats& stats) {
+    if (!less(data[mid], data[mid - 1])) {
+        #pragma omp atomic
+        stats.skippedMerges++;
+        return;
+    }
+    const size_t a = std::upper_bound(data + lo, data + mid, data[mid], less) - data;
+    const size_t b = std::lower_bound(data + mid, data + hi, data[mid - 1], less) - data;
+    parallelMerge(data + a, (int64_t)(mid - a), data + mid, (int64_t)(b - mid), buffer + a, slices, less);
+    const size_t len = b - a;
+    for (int s = 0; s < slices; s++) {
+        #pragma omp task firstprivate(s) if(slices > 1)
+        std::copy(buffer + a + len * s / slices, buffer + a + len * (s + 1) / slices, data + a + len * s / slices);
+    }
+    #pragma omp taskwait
+    #pragma omp atomic
+    stats.merges++;
+    #pragma omp atomic
+    stats.mergedElements += len;
+}
+
+// Merges the subtree under node; sibling subtrees run as tasks while they
+// are large enough to be worth one
+template <typename T, typename Less>
+void mergeTree(T* data, T* buffer, const std::vector<Node>& tree, int node, size_t n, Less less,
+               NaturalSortStats& stats) {
+    const Node& nd = tree[node];
+    if (nd.left < 0) return;
+    const size_t minTask = 1 << 14;
+    #pragma omp task shared(tree, stats) if(tree[nd.left].hi - tree[nd.left].lo >= minTask)
+    mergeTree(data, buffer, tree, nd.left, n, less, stats);
+    #pragma omp task shared(tree, stats) if(tree[nd.right].hi - tree[nd.right].lo >= minTask)
+    mergeTree(data, buffer, tree, nd.right, n, less, stats);
+    #pragma omp taskwait
+    const int slices = (int)std::max<size_t>(1, omp_get_num_threads() * (nd.hi - nd.lo) / n);
+    mergeAdjacent(data, buffer, nd.lo, nd.mid, nd.hi, nd.hi - nd.lo >= 8192 ? slices : 1, less, stats);
+}
+
+} // namespace natural_detail
+
+// Sorts data[0, n) using buffer[0, n) as scratch.
+//  1. Run detection: about four chunks per thread are scanned in parallel
+//     for maximal non-descending or strictly descending runs; descending
+//     runs are reversed and runs shorter than minRun are padded out by
+//     binary insertion (so random input still gets runs of minRun). Runs
+//     that meet in order at a chunk boundary are joined.
+//  2. Merge policy: the powersort rule builds a merge tree in which each
+//     boundary's depth follows its node power, which keeps the tree nearly
+//     balanced by length (O(n H) work for run-length entropy H, so O(n) for
+//     a few runs and O(n log n) at worst).
+//  3. The tree is merged bottom-up with tasks for sibling subtrees and merge
+//     path for the large merges. A merge of runs already in order costs one
+//     comparison, and otherwise only the overlapping parts are merged.
+template <typename T, typename Less = std::less<T>>
+NaturalSortStats naturalMergeSortParallel(T* data, size_t n, T* buffer, Less less = Less(), size_t minRun = 32) {
+    using namespace natural_detail;
+    NaturalSortStats stats;
+    if (n < 2) return stats;
+
+    // 1. Runs per chunk, then joined across chunk boundaries
+    const int threads = omp_get_max_threads();
+    const size_t chunks = std::max<size_t>(1, std::min<size_t>(4 * threads, n / 4096));
+    std::vector<std::vector<Run>> chunkRuns(chunks);
+    std::vector<size_t> chunkReversed(chunks, 0);
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int64_t c = 0; c < (int64_t)chunks; c++) {
+        findRuns(data, n * c / chunks, n * (c + 1) / chunks, minRun, less, chunkRuns[c], chunkReversed[c]);
+    }
+    std::vector<Run> runs;
+    for (size_t c = 0; c < chunks; c++) {
+        stats.reversed += chunkReversed[c];
+        for (const Run& r : chunkRuns[c]) {
+            if (!runs.empty() && !less(data[r.lo], data[r.lo - 1])) runs.back().hi = r.hi;
+            else runs.push_back(r);
+        }
+    }
+    stats.runs = runs.size();
+    if (runs.size() == 1) return stats;
+
+    // 2. Powersort merge tree; the stack holds (node, power of its right boundary)
+    std::vector<Node> tree;
+    for (const Run& r : runs) tree.push_back({r.lo, r.hi, r.hi, -1, -1});
+    auto join = [&](int left, int right) {
+        tree.push_back({tree[left].lo, tree[left].hi, tree[right].hi, left, right});
+        return (int)tree.size() - 1;
+    };
+    std::vector<std::pair<int, int>> stack;
+    int current = 0;
+    for (size_t i = 1; i < runs.size(); i++) {
+        const int power = nodePower(runs[i - 1].lo, runs[i].lo, runs[i].hi, n);
+        while (!stack.empty() && stack.back().second > power) {
+            current = join(stack.back().first, current);
+            stack.pop_back();
+        }
+        stack.push_back({current, power});
+        current = (int)i;
+    }
+    while (!stack.empty()) {
+        current = join(stack.back().first, current);
+        stack.pop_back();
+    }
+
+    // 3. Merge the tree
+    #pragma omp parallel
+    #pragma omp single
+    mergeTree(data, buffer, tree, current, n, less, stats);
+    return stats;
+}
+
+template <typename T>
+NaturalSortStats naturalMergeSortParallel(std::vector<T>& data) {
+    std::vector<T> buffer(data.size());
+    return naturalMergeSortParallel(data.data(), data.size(), buffer.data());
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include <omp.h>
+
+// Block odd-even transposition sort (Baudet-Stevenson merge-split): the
+// element-level odd-even bubble sort lifted to one block per thread, so the
+// team synchronizes p times instead of n.
+
+// Bubble sort of [first, last) with the early exit of bubbleSortSequential
+template <typename T>
+void bubbleSortRange(T* first, T* last) {
+    for (T* end = last; end - first > 1; --end) {
+        bool swapped = false;
+        for (T* p = first; p + 1 < end; ++p) {
+            if (p[1] < p[0]) {
+                std::swap(p[0], p[1]);
+                swapped = true;
+            }
+        }
+        if (!swapped) break;
+    }
+}
+
+// Sorts arr with one contiguous block per thread inside a single parallel
+// region:
+//  1. Every thread sorts its block with localSort(first, last).
+//  2. Rounds of merge-split. In round r, blocks i and i + 1 with
+//     i % 2 == r % 2 are paired: the lower thread merges the pair from the
+//     front and keeps the smallest |block i| keys, the upper thread merges
+//     from the back and keeps the largest, each writing only its own block.
+//     A pair already in order (last of i <= first of i + 1) just copies.
+//  3. The sort stops after an odd and an even round in a row without a
+//     merge, like the `swapped` early exit: p rounds for equal blocks (0-1
+//     principle, as for the element-level sort with p "elements"), a couple
+//     more when n % p makes the blocks differ by one, 2 on sorted input.
+// Rounds read one buffer and write the other, so a round needs only one
+// barrier. Returns the number of rounds.
+template <typename T, typename LocalSort>
+int oddEvenMergeSplitSort(std::vector<T>& arr, LocalSort localSort) {
+    const size_t n = arr.size();
+    std::vector<T> scratch(n);
+    int merged[4] = {0, 0, 0, 0}; // Whether round r merged anything, in slot r % 4
+    int rounds = 0;
+    #pragma omp parallel
+    {
+        // One block per thread, but no empty blocks: they would cut the chain of pairs
+        const int p = (int)std::max<size_t>(1, std::min<size_t>(omp_get_num_threads(), n));
+        const int id = std::min(omp_get_thread_num(), p);
+        auto bound = [&](int b) { return n * std::min(b, p) / p; };
+        const size_t lo = bound(id), hi = bound(id + 1);
+        T* src = arr.data();
+        T* dst = scratch.data();
+
+        localSort(src + lo, src + hi);
+        #pragma omp barrier
+
+        for (int round = 0;; round++) {
+            // Slot (round + 1) % 4 was last read after round round - 3
+            if (id == 0) merged[(round + 1) % 4] = 0;
+            const int partner = (id - round) % 2 == 0 ? id + 1 : id - 1;
+            const size_t plo = partner >= 0 && partner < p ? bound(partner) : 0;
+            const size_t phi = partner >= 0 && partner < p ? bound(partner + 1) : 0;
+            const bool paired = partner >= 0 && partner < p && lo < hi && plo < phi;
+            if (!paired || (id < partner ? !(src[plo] < src[hi - 1]) : !(src[lo] < src[phi - 1]))) {
+                std::copy(src + lo, src + hi, dst + lo);
+            } else {
+                if (id < partner) {
+                    // Smallest keys of [lo, hi) + [plo, phi), ties to the left block
+                    size_t i = lo, j = plo;
+                    for (size_t k = lo; k < hi; k++) dst[k] = (j < phi && src[j] < src[i]) ? src[j++] : src[i++];
+                } else {
+                    // Largest keys of [plo, phi) + [lo, hi), ties to the right block
+                    size_t i = phi, j = hi;
+                    for (size_t k = hi; k > lo; k--) {
+                        dst[k - 1] = (i > plo && src[j - 1] < src[i - 1]) ? src[--i] : src[--j];
+                    }
+                }
+                #pragma omp atomic write
+                merged[round % 4] = 1;
+            }
+            #pragma omp barrier
+            std::swap(src, dst);
+            if (round >= 1 && !merged[round % 4] && !merged[(round - 1) % 4]) {
+                if (id == 0) rounds = round + 1;
+                break;
+            }
+        }
+        if (src != arr.data()) std::copy(src + lo, src + hi, arr.data() + lo);
+    }
+    return rounds;
+}
+
+// Local blocks sorted with std::sort
+template <typename T>
+int oddEvenMergeSplitSort(std::vector<T>& arr) {
+    return oddEvenMergeSplitSort(arr, [](T* first, T* last) { std::sort(first, last); });
+}
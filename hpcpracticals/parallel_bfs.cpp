@@ -4,17 +4,24 @@
 #include <omp.h>
 #include <chrono>
 #include <queue>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <random>
+#include "csr_graph.h"
+#include "bfs.h"
+#include "graph_io.h"
+#include "reorder.h"
 
 using namespace std;
 
-const int MAXN = 1e5;
-vector<int> adj[MAXN + 5]; // Adjacency list
-bool visited[MAXN + 5];    // Revert to bool for simplicity with atomic section
+CSRGraph<> graph;          // Graph in CSR form (vertices are 0-based internally)
+vector<char> visited;      // One byte per vertex, sized from the graph
 vector<int> visitedOrder;  // Store the order of visited nodes
 
 // Sequential BFS
-void sequentialBFS(int start, int n) {
-    for (int i = 1; i <= n; i++) visited[i] = false;
+void sequentialBFS(const CSRGraph<>& g, int start) {
+    visited.assign(g.numVertices(), false);
     visitedOrder.clear();
 
     queue<int> q;
@@ -26,7 +33,7 @@ void sequentialBFS(int start, int n) {
         int node = q.front();
         q.pop();
 
-        for (int next_node : adj[node]) {
+        for (int next_node : g.neighbors(node)) {
             if (!visited[next_node]) {
                 visited[next_node] = true;
                 visitedOrder.push_back(next_node);
@@ -36,96 +43,220 @@ void sequentialBFS(int start, int n) {
     }
 }
 
-// Parallel BFS using OpenMP
-void parallelBFS(int start, int n, int numThreads) {
+// Parallel BFS using OpenMP: lock-free frontier engine from bfs.h
+// (flat frontier array, atomic visited bitmap, prefix-sum compaction)
+BFSResult<int> parallelResult;
+void parallelBFS(const CSRGraph<>& g, int start, int numThreads) {
     omp_set_num_threads(numThreads);
-    for (int i = 1; i <= n; i++) visited[i] = false;
-    visitedOrder.clear();
+    parallelResult = frontierBFS(g, start, &visitedOrder);
+}
 
-    queue<int> q;
-    q.push(start);
-    visited[start] = true;
-    visitedOrder.push_back(start);
+// Answers `queries` BFS queries (the start node plus random vertices) twice:
+// one frontierBFS per source, then batched multi-source passes
+void runMultiSourceQueries(const CSRGraph<>& g, int source, int queries, int batchSize) {
+    vector<int> sources(1, source);
+    mt19937 rng(42);
+    uniform_int_distribution<int> pick(0, g.numVertices() - 1);
+    while ((int)sources.size() < queries) sources.push_back(pick(rng));
 
-    while (!q.empty()) {
-        int currentLevelSize = q.size();
-        vector<vector<int>> localNextLevel(numThreads);
-
-        #pragma omp parallel
-        {
-            int tid = omp_get_thread_num();
-
-            #pragma omp for schedule(static)
-            for (int i = 0; i < currentLevelSize; i++) {
-                int node = q.front();
-                q.pop();  // Thread-safe as each thread is responsible for popping one element
-
-                // Explore neighbors
-                for (int next_node : adj[node]) {
-                    if (!visited[next_node]) {
-                        visited[next_node] = true;
-                        localNextLevel[tid].push_back(next_node);  // Add to thread-local queue
-                    }
-                }
-            }
-        }
+    auto start = chrono::high_resolution_clock::now();
+    vector<vector<int32_t>> levels(queries);
+    for (int i = 0; i < queries; i++) levels[i] = frontierBFS(g, sources[i]).level;
+    auto end = chrono::high_resolution_clock::now();
+    double single_time = chrono::duration<double, milli>(end - start).count();
 
-        // Merge thread-local results back into the global queue for the next level
-        for (int t = 0; t < numThreads; t++) {
-            for (int next_node : localNextLevel[t]) {
-                q.push(next_node);  // Push local results to the global queue
-                visitedOrder.push_back(next_node); // Store visited node
+    MultiSourceBFSOptions msOptions;
+    msOptions.batchSize = batchSize;
+    start = chrono::high_resolution_clock::now();
+    MultiSourceBFSResult<int> batched = multiSourceBFS(g, sources, msOptions);
+    end = chrono::high_resolution_clock::now();
+    double batch_time = chrono::duration<double, milli>(end - start).count();
+
+    bool correct = true;
+    for (int i = 0; i < queries && correct; i++) {
+        for (int v = 0; v < g.numVertices(); v++) {
+            if (batched.dist(i, v) != levels[i][v] || batched.reaches(i, v) != (levels[i][v] >= 0)) {
+                correct = false;
+                break;
             }
         }
     }
+
+    cout << "\nMulti-Source BFS (" << queries << " queries, batches of " << msOptions.batchSize << ")\n";
+    cout << "One BFS per query: " << single_time << " ms\n";
+    cout << "Batched multi-source BFS: " << batch_time << " ms\n";
+    cout << "Speedup: " << single_time / batch_time << "\n";
+    cout << "Edges examined (batched): " << batched.edgesExamined << "\n";
+    cout << "Multi-Source Correctness: " << (correct ? "Pass" : "Fail") << "\n";
 }
 
-int main() {
-    int n, m, start_node, numThreads;
-    cout << "Enter number of nodes, edges, and threads: ";
-    cin >> n >> m >> numThreads;
-    cout << "Enter start node: ";
-    cin >> start_node;
+// Preprocessing for --reorder: relabels g for locality, replacing it and
+// mapping source to its new id, so every run after this one traverses the
+// relabelled graph. The same BFS is timed before and after; levels from the
+// relabelled run are mapped back through the permutation, so they must equal
+// the original run vertex for vertex.
+Relabeling<int> reorderGraph(CSRGraph<>& g, int& source, VertexOrdering ordering, const HybridBFSOptions& hybridOptions) {
+    auto start = chrono::high_resolution_clock::now();
+    BFSResult<int> before = frontierBFS(g, source);
+    auto end = chrono::high_resolution_clock::now();
+    double before_time = chrono::duration<double, milli>(end - start).count();
+    start = chrono::high_resolution_clock::now();
+    hybridBFS(g, source, hybridOptions);
+    end = chrono::high_resolution_clock::now();
+    double hybrid_before = chrono::duration<double, milli>(end - start).count();
+    const double gapBefore = averageEdgeGap(g);
+
+    start = chrono::high_resolution_clock::now();
+    Relabeling<int> relabel = computeOrdering(g, ordering);
+    g = relabelGraph(g, relabel);
+    end = chrono::high_resolution_clock::now();
+    double reorder_time = chrono::duration<double, milli>(end - start).count();
+    source = relabel.newId[source];
+
+    start = chrono::high_resolution_clock::now();
+    BFSResult<int> after = frontierBFS(g, source);
+    end = chrono::high_resolution_clock::now();
+    double after_time = chrono::duration<double, milli>(end - start).count();
+    start = chrono::high_resolution_clock::now();
+    hybridBFS(g, source, hybridOptions);
+    end = chrono::high_resolution_clock::now();
+    double hybrid_after = chrono::duration<double, milli>(end - start).count();
+
+    bool correct = validateBFSTree(g, source, after);
+    for (int v = 0; v < g.numVertices() && correct; v++) {
+        correct = after.level[relabel.newId[v]] == before.level[v];
+    }
+
+    cout << "Reordering (" << orderingName(ordering) << "): " << reorder_time << " ms\n";
+    cout << "Average edge gap: " << gapBefore << " -> " << averageEdgeGap(g) << "\n";
+    cout << "Parallel BFS Time: " << before_time << " ms -> " << after_time << " ms (x"
+         << before_time / after_time << ")\n";
+    cout << "Hybrid BFS Time: " << hybrid_before << " ms -> " << hybrid_after << " ms (x"
+         << hybrid_before / hybrid_after << ")\n";
+    cout << "Reordered Correctness: " << (correct ? "Pass" : "Fail") << "\n";
+    cout << "Runs below use the relabelled graph\n\n";
+    return relabel;
+}
 
-    // Input validation
-    if (n < 1 || n > MAXN) {
-        cout << "Number of nodes must be between 1 and " << MAXN << ".\n";
+int main(int argc, char* argv[]) {
+    // Non-interactive mode: --graph <file> --source <s> --threads <t> [--load-only] [--dedup] [--save-binary <out.bin>]
+    // Hybrid BFS tuning: --alpha <a> --beta <b>
+    // Batched queries: --multi-source <k> [--batch <b>]
+    // Locality relabelling: --reorder degree|rcm|bfs
+    GraphOptions options;
+    HybridBFSOptions hybridOptions;
+    VertexOrdering ordering = VertexOrdering::Original;
+    int multiSourceQueries = 0, batchSize = 512;
+    for (int i = 1; i < argc; i++) {
+        if (parseGraphOption(argc, argv, i, options)) continue;
+        if (i + 1 < argc && strcmp(argv[i], "--alpha") == 0) hybridOptions.alpha = atof(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "--beta") == 0) hybridOptions.beta = atof(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "--multi-source") == 0) multiSourceQueries = atoi(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "--batch") == 0) batchSize = atoi(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "--reorder") == 0) {
+            try {
+                ordering = parseOrdering(argv[++i]);
+            } catch (const exception& e) {
+                cout << e.what() << "\n";
+                return 1;
+            }
+        } else {
+            cout << "Usage: " << argv[0] << " [--graph file --source s --threads t] [--load-only]"
+                 << " [--dedup] [--save-binary out.bin] [--alpha a] [--beta b]"
+                 << " [--multi-source k] [--batch b] [--reorder degree|rcm|bfs]\n";
+            return 1;
+        }
+    }
+    if (hybridOptions.alpha <= 0 || hybridOptions.beta <= 0) {
+        cout << "Alpha and beta must be positive.\n";
         return 1;
     }
-    if (m < 0) {
-        cout << "Number of edges cannot be negative.\n";
+    if (multiSourceQueries < 0 || batchSize < 64 || batchSize > 512) {
+        cout << "Multi-source queries must be non-negative and the batch size between 64 and 512.\n";
         return 1;
     }
-    if (start_node < 1 || start_node > n) {
-        cout << "Start node must be between 1 and " << n << ".\n";
+
+    int n, numThreads;
+    long long start_node;
+    int base; // Numbering used for input/output vertex ids
+    vector<CSRGraph<>::Edge> edges;
+
+    if (options.graphFile.empty()) {
+        int m;
+        cout << "Enter number of nodes, edges, and threads: ";
+        cin >> n >> m >> numThreads;
+        cout << "Enter start node: ";
+        cin >> start_node;
+        base = 1;
+
+        // Input validation
+        if (n < 1) {
+            cout << "Number of nodes must be at least 1.\n";
+            return 1;
+        }
+        if (m < 0) {
+            cout << "Number of edges cannot be negative.\n";
+            return 1;
+        }
+
+        // Input edges (1-based on input, stored 0-based)
+        edges.reserve(m);
+        cout << "Enter " << m << " edges (format: u v):\n";
+        for (int i = 0; i < m; i++) {
+            int u, v;
+            cin >> u >> v;
+            if (u < 1 || u > n || v < 1 || v > n) {
+                cout << "Invalid edge (" << u << ", " << v << "). Vertices must be between 1 and " << n << ".\n";
+                return 1;
+            }
+            edges.emplace_back(u - 1, v - 1);
+        }
+    } else {
+        if (!loadGraphEdges(options, edges, n, base)) return 1;
+        if (n < 1) {
+            cout << "Graph has no vertices.\n";
+            return 1;
+        }
+        start_node = options.source;
+        numThreads = options.threads > 0 ? options.threads : omp_get_max_threads();
+    }
+
+    if (start_node < base || start_node >= (long long)n + base) {
+        cout << "Start node must be between " << base << " and " << (long long)n + base - 1 << ".\n";
         return 1;
     }
     if (numThreads < 1) {
         cout << "Number of threads must be at least 1.\n";
         return 1;
     }
+    int source = (int)(start_node - base);
 
-    // Clear adjacency list
-    for (int i = 1; i <= n; i++) {
-        adj[i].clear();
+    // Typed-in graphs keep their input neighbour order; file graphs use the parallel builder
+    auto buildStart = chrono::high_resolution_clock::now();
+    if (options.graphFile.empty()) {
+        graph = CSRGraph<>::fromEdges(n, edges);
+    } else {
+        CSRBuildOptions buildOptions;
+        buildOptions.removeSelfLoops = buildOptions.removeDuplicates = options.dedup;
+        graph = CSRGraph<>::fromEdgesParallel(n, edges, buildOptions);
     }
-
-    // Input edges
-    cout << "Enter " << m << " edges (format: u v):\n";
-    for (int i = 0; i < m; i++) {
-        int u, v;
-        cin >> u >> v;
-        if (u < 1 || u > n || v < 1 || v > n) {
-            cout << "Invalid edge (" << u << ", " << v << "). Vertices must be between 1 and " << n << ".\n";
-            return 1;
-        }
-        adj[u].push_back(v);
-        adj[v].push_back(u);
+    auto buildEnd = chrono::high_resolution_clock::now();
+    edges = vector<CSRGraph<>::Edge>();
+    if (!options.graphFile.empty()) {
+        cout << "CSR Build Time: " << chrono::duration<double, milli>(buildEnd - buildStart).count() << " ms ("
+             << graph.numArcs() << " arcs)\n";
+        if (options.loadOnly) return 0;
     }
 
+    // Optional relabelling; printed vertex ids are mapped back to the input's
+    omp_set_num_threads(numThreads);
+    Relabeling<int> relabel;
+    if (ordering != VertexOrdering::Original) relabel = reorderGraph(graph, source, ordering, hybridOptions);
+    auto inputId = [&](int v) { return (relabel.oldId.empty() ? v : relabel.oldId[v]) + base; };
+
     // Sequential BFS
     auto start = chrono::high_resolution_clock::now();
-    sequentialBFS(start_node, n);
+    sequentialBFS(graph, source);
     auto end = chrono::high_resolution_clock::now();
     double seq_time = chrono::duration<double, milli>(end - start).count();
 
@@ -133,20 +264,16 @@ int main() {
 
     // Parallel BFS
     start = chrono::high_resolution_clock::now();
-    parallelBFS(start_node, n, numThreads);
+    parallelBFS(graph, source, numThreads);
     end = chrono::high_resolution_clock::now();
     double par_time = chrono::duration<double, milli>(end - start).count();
 
-    // Verify correctness
-    bool correct = (seqVisitedOrder.size() == visitedOrder.size());
-    if (correct) {
-        for (size_t i = 0; i < seqVisitedOrder.size(); i++) {
-            if (seqVisitedOrder[i] != visitedOrder[i]) {
-                correct = false;
-                break;
-            }
-        }
-    }
+    // Verify correctness: same reachable set and a valid BFS tree
+    bool correct = (seqVisitedOrder.size() == visitedOrder.size()) &&
+                   validateBFSTree(graph, source, parallelResult);
+
+    // Within a level the parallel order depends on which thread claims a vertex first
+    bool sameOrder = (seqVisitedOrder == visitedOrder);
 
     // Print performance metrics
     cout << "Sequential BFS Time: " << seq_time << " ms\n";
@@ -155,13 +282,51 @@ int main() {
     cout << "Threads Used: " << numThreads << "\n";
     cout << "Efficiency: " << (seq_time / par_time) / numThreads << "\n";
     cout << "Correctness: " << (correct ? "Pass" : "Fail") << "\n";
+    cout << "Visit order matches sequential: " << (sameOrder ? "Yes" : "No") << "\n";
+
+    // Deterministic parallel BFS: must reproduce the sequential visit order
+    vector<int> deterministicOrder;
+    start = chrono::high_resolution_clock::now();
+    BFSResult<int> deterministic = deterministicBFS(graph, source, &deterministicOrder);
+    end = chrono::high_resolution_clock::now();
+    double det_time = chrono::duration<double, milli>(end - start).count();
+
+    cout << "\nDeterministic BFS Time: " << det_time << " ms\n";
+    cout << "Deterministic Speedup: " << seq_time / det_time << "\n";
+    cout << "Deterministic Correctness: " << (validateBFSTree(graph, source, deterministic) ? "Pass" : "Fail") << "\n";
+    cout << "Deterministic order matches sequential: " << (deterministicOrder == seqVisitedOrder ? "Yes" : "No") << "\n";
+
+    // Direction-optimizing (hybrid) BFS
+    start = chrono::high_resolution_clock::now();
+    BFSResult<int> hybrid = hybridBFS(graph, source, hybridOptions);
+    end = chrono::high_resolution_clock::now();
+    double hybrid_time = chrono::duration<double, milli>(end - start).count();
 
-    // Print visited nodes
-    cout << "Visited nodes: ";
-    for (int node : visitedOrder) {
-        cout << node << " ";
+    cout << "\nHybrid BFS Time: " << hybrid_time << " ms (alpha = " << hybridOptions.alpha
+         << ", beta = " << hybridOptions.beta << ")\n";
+    cout << "Hybrid Speedup: " << seq_time / hybrid_time << "\n";
+    cout << "Hybrid Correctness: "
+         << (hybrid.reached == (int64_t)seqVisitedOrder.size() && validateBFSTree(graph, source, hybrid)
+             ? "Pass" : "Fail") << "\n";
+    cout << "Level  Direction  Frontier  Edges Examined  Time (ms)\n";
+    for (const BFSLevelStats& lvl : hybrid.levels) {
+        cout << setw(5) << lvl.level << "  " << setw(9) << directionName(lvl.direction) << "  "
+             << setw(8) << lvl.frontierVertices << "  " << setw(14) << lvl.edgesExamined << "  "
+             << setw(9) << lvl.ms << "\n";
+    }
+
+    if (multiSourceQueries > 0) runMultiSourceQueries(graph, source, multiSourceQueries, batchSize);
+
+    // Print visited nodes (typed-in graphs only; file graphs can have millions)
+    if (options.graphFile.empty()) {
+        cout << "Visited nodes: ";
+        for (int node : visitedOrder) {
+            cout << inputId(node) << " ";
+        }
+        cout << "\n";
+    } else {
+        cout << "Visited nodes: " << visitedOrder.size() << "\n";
     }
-    cout << "\n";
 
     return 0;
 }
@@ -1,245 +1,305 @@
 #include <iostream>
 #include <vector>
-#include <queue>
-#include <stack>
 #include <omp.h>
 #include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include "csr_graph.h"
+#include "bfs.h"
+#include "dfs.h"
+#include "graph_generators.h"
+#include "dynamic_graph.h"
+#include <random>
 
 using namespace std;
 
-// Class to represent an undirected graph using adjacency list
+// Output of one traversal. The arrays are allocated once by the caller and
+// refilled by every run; with the engines' scratch space kept in Graph, a
+// timed traversal does no printing and, once warm, no allocation.
+struct TraversalResult {
+    vector<int> distance; // BFS level or DFS tree depth, -1 if unreached
+    vector<int> parent;   // -1 if unreached, the start vertex is its own parent
+    vector<int> order;    // Vertices in visit order
+
+    explicit TraversalResult(int vertices) { reset(vertices); order.reserve(vertices); }
+
+    void reset(int vertices) {
+        distance.assign(vertices, -1);
+        parent.assign(vertices, -1);
+        order.clear();
+    }
+};
+
+// Class to represent an undirected graph stored in CSR form
 class Graph {
     int V; // Number of vertices
-    vector<vector<int>> adj; // Adjacency list
+    vector<CSRGraph<>::Edge> edges; // Edges added since the last build
+    DynamicGraph<> adj; // CSR adjacency used by every traversal, updated in place by each batch
+    bool built = false;
+    BFSResult<int> bfsState; // Engine state and scratch space, kept between runs
+    DFSResult<int> dfsState;
+    BFSWorkspace<int> bfsWork;
+    DFSWorkspace<int> dfsWork;
+    vector<int> queue;             // Sequential BFS queue
+    vector<pair<int, int>> stack;  // Sequential DFS stack of (vertex, parent)
 
 public:
-    Graph(int vertices) : V(vertices) {
-        adj.resize(V);
+    Graph(int vertices) : V(vertices) {}
+
+    // Freeze the pending edge list into CSR form; traversals call this
+    // themselves, but calling it first keeps the build out of their timing
+    void build() {
+        if (built) return;
+        if (adj.numVertices() == V) {
+            adj.applyBatch(edges, {}); // Edges added after an earlier build
+        } else {
+            CSRBuildOptions options;
+            options.sortNeighbors = true; // Keep the printed traversal order stable between runs
+            adj = DynamicGraph<>(CSRGraph<>::fromEdgesParallel(V, edges, options));
+        }
+        edges.clear();
+        built = true;
+
+        // Size the scratch space here so the traversals' first runs do not pay for it
+        bfsWork.reserve(V);
+        dfsWork.reserve(V);
+        queue.reserve(V);
+        stack.reserve(V);
     }
 
     // Function to add an edge to the graph (undirected)
     void addEdge(int v, int w) {
-        adj[v].push_back(w);
-        adj[w].push_back(v);
+        edges.emplace_back(v, w);
+        built = false;
+    }
+
+    // Apply a batch of edge insertions and deletions to the touched lists only
+    void applyBatch(const vector<CSRGraph<>::Edge>& insertions, const vector<CSRGraph<>::Edge>& deletions) {
+        build();
+        adj.applyBatch(insertions, deletions);
+    }
+
+    const DynamicGraph<>& graph() {
+        build();
+        return adj;
+    }
+
+    // Repair out.distance / out.parent, which hold a BFS from start on the
+    // graph before the batch, after applyBatch. Only the affected region is
+    // touched unless the change is large (see repairBFS). The visit order is
+    // not maintained and is cleared.
+    BFSRepairStats incrementalBFS(int start, TraversalResult& out, const vector<CSRGraph<>::Edge>& insertions,
+                                  const vector<CSRGraph<>::Edge>& deletions) {
+        build();
+        out.order.clear();
+        return repairBFS(adj, start, insertions, deletions, out.distance, out.parent);
+    }
+
+    // Neighbours of v in the current graph
+    CSRGraph<>::NeighborRange neighbors(int v) {
+        build();
+        return adj.neighbors(v);
     }
 
     // Sequential BFS
-    void sequentialBFS(int start) {
-        vector<bool> visited(V, false);
-        queue<int> q;
-
-        visited[start] = true;
-        q.push(start);
-
-        while (!q.empty()) {
-            int vertex = q.front();
-            q.pop();
-            cout << vertex << " ";
-
-            for (int neighbor : adj[vertex]) {
-                if (!visited[neighbor]) {
-                    visited[neighbor] = true;
-                    q.push(neighbor);
+    void sequentialBFS(int start, TraversalResult& out) {
+        build();
+        out.reset(V);
+        queue.clear();
+
+        out.distance[start] = 0;
+        out.parent[start] = start;
+        queue.push_back(start);
+
+        for (size_t head = 0; head < queue.size(); head++) {
+            int vertex = queue[head];
+            out.order.push_back(vertex);
+
+            for (int neighbor : adj.neighbors(vertex)) {
+                if (out.distance[neighbor] < 0) {
+                    out.distance[neighbor] = out.distance[vertex] + 1;
+                    out.parent[neighbor] = vertex;
+                    queue.push_back(neighbor);
                 }
             }
         }
-        cout << endl;
-    }
-
-    // Parallel BFS using OpenMP
-    void parallelBFS(int start) {
-        vector<bool> visited(V, false);
-        queue<int> q;
-
-        visited[start] = true;
-        q.push(start);
-
-        while (!q.empty()) {
-            int levelSize = q.size();
-
-            // Parallelize the processing of nodes at the current level
-            #pragma omp parallel
-            {
-                queue<int> localQ; // Thread-local queue for next level
-                #pragma omp for
-                for (int i = 0; i < levelSize; i++) {
-                    int vertex;
-                    #pragma omp critical
-                    {
-                        vertex = q.front();
-                        q.pop();
-                    }
-                    cout << vertex << " ";
-
-                    for (int neighbor : adj[vertex]) {
-                        bool shouldVisit = false;
-                        #pragma omp critical
-                        {
-                            if (!visited[neighbor]) {
-                                visited[neighbor] = true;
-                                shouldVisit = true;
-                            }
-                        }
-                        if (shouldVisit) {
-                            localQ.push(neighbor);
-                        }
-                    }
-                }
+    }
 
-                // Merge thread-local queues into the main queue
-                #pragma omp critical
-                {
-                    while (!localQ.empty()) {
-                        q.push(localQ.front());
-                        localQ.pop();
-                    }
-                }
-            }
-        }
-        cout << endl;
+    // Parallel BFS using OpenMP: lock-free frontier engine from bfs.h
+    // (flat frontier array, atomic visited bitmap, no critical sections).
+    // The caller's arrays are swapped into the engine and back, so nothing is copied.
+    void parallelBFS(int start, TraversalResult& out) {
+        build();
+        bfsState.level.swap(out.distance);
+        bfsState.parent.swap(out.parent);
+        frontierBFS(adj, start, bfsState, bfsWork, &out.order);
+        bfsState.level.swap(out.distance);
+        bfsState.parent.swap(out.parent);
     }
 
     // Sequential DFS
-    void sequentialDFS(int start) {
-        vector<bool> visited(V, false);
-        stack<int> s;
-
-        s.push(start);
-        while (!s.empty()) {
-            int vertex = s.top();
-            s.pop();
-
-            if (!visited[vertex]) {
-                visited[vertex] = true;
-                cout << vertex << " ";
-
-                for (int neighbor : adj[vertex]) {
-                    if (!visited[neighbor]) {
-                        s.push(neighbor);
+    void sequentialDFS(int start, TraversalResult& out) {
+        build();
+        out.reset(V);
+        stack.clear();
+
+        stack.push_back({start, start});
+        while (!stack.empty()) {
+            auto [vertex, parent] = stack.back();
+            stack.pop_back();
+
+            if (out.parent[vertex] < 0) {
+                out.parent[vertex] = parent;
+                out.distance[vertex] = vertex == parent ? 0 : out.distance[parent] + 1;
+                out.order.push_back(vertex);
+
+                for (int neighbor : adj.neighbors(vertex)) {
+                    if (out.parent[neighbor] < 0) {
+                        stack.push_back({neighbor, vertex});
                     }
                 }
             }
         }
-        cout << endl;
-    }
-
-    // Parallel DFS using OpenMP
-    void parallelDFS(int start) {
-        vector<bool> visited(V, false);
-        stack<int> s;
-
-        s.push(start);
-        while (!s.empty()) {
-            int levelSize = s.size();
-
-            // Parallelize the processing of nodes at the current stack level
-            #pragma omp parallel
-            {
-                stack<int> localS; // Thread-local stack for next level
-                #pragma omp for
-                for (int i = 0; i < levelSize; i++) {
-                    int vertex = -1; // Default value to indicate no vertex
-                    bool proceed = false;
-                    #pragma omp critical
-                    {
-                        if (!s.empty()) {
-                            vertex = s.top();
-                            s.pop();
-                            proceed = true;
-                        }
-                    }
+    }
 
-                    // Only proceed if we successfully popped a vertex
-                    if (proceed) {
-                        bool shouldProcess = false;
-                        #pragma omp critical
-                        {
-                            if (!visited[vertex]) {
-                                visited[vertex] = true;
-                                shouldProcess = true;
-                            }
-                        }
-
-                        if (shouldProcess) {
-                            cout << vertex << " ";
-                            for (int neighbor : adj[vertex]) {
-                                bool shouldPush = false;
-                                #pragma omp critical
-                                {
-                                    if (!visited[neighbor]) {
-                                        visited[neighbor] = true;
-                                        shouldPush = true;
-                                    }
-                                }
-                                if (shouldPush) {
-                                    localS.push(neighbor);
-                                }
-                            }
-                        }
-                    }
-                }
+    // Parallel DFS using OpenMP: work-stealing engine from dfs.h
+    // (per-thread deques, atomic CAS claims, no critical sections).
+    // Parents are discovered before their children, so one pass over the
+    // discovery order gives every tree depth.
+    void parallelDFS(int start, TraversalResult& out) {
+        build();
+        dfsState.parent.swap(out.parent);
+        dfsState.order.swap(out.order);
+        workStealingDFS(adj, start, dfsState, dfsWork);
+        dfsState.parent.swap(out.parent);
+        dfsState.order.swap(out.order);
+
+        out.distance.assign(V, -1);
+        for (int vertex : out.order) {
+            int parent = out.parent[vertex];
+            out.distance[vertex] = parent == vertex ? 0 : out.distance[parent] + 1;
+        }
+    }
+};
 
-                // Merge thread-local stacks into the main stack
-                #pragma omp critical
-                {
-                    while (!localS.empty()) {
-                        s.push(localS.top());
-                        localS.pop();
-                    }
-                }
+// Writes traversal results after timing has stopped. Each thread formats a
+// contiguous slice of the array into its own buffer, and the buffers are then
+// written in slice order, so the output is identical to a sequential loop.
+class ResultWriter {
+    ostream& out;
+    vector<string> buffers;
+
+public:
+    explicit ResultWriter(ostream& stream) : out(stream), buffers(omp_get_max_threads()) {}
+
+    void write(const string& label, const vector<int>& values) {
+        const int64_t count = values.size();
+        int usedThreads = 1;
+        #pragma omp parallel
+        {
+            const int tid = omp_get_thread_num();
+            const int nt = omp_get_num_threads();
+            if (tid == 0) usedThreads = nt;
+            string& local = buffers[tid];
+            local.clear();
+            for (int64_t i = count * tid / nt; i < count * (tid + 1) / nt; i++) {
+                local += to_string(values[i]);
+                local += ' ';
             }
         }
-        cout << endl;
+        out << label;
+        for (int t = 0; t < usedThreads; t++) out << buffers[t];
+        out << "\n";
     }
 };
 
-int main() {
+int main(int argc, char* argv[]) {
+    // Optional: --random <n> <m> for an Erdos-Renyi graph instead of the sample,
+    // --quiet to skip writing the traversal orders,
+    // --updates <k> for k random insertions and k random deletions per update batch
+    int randomVertices = 0;
+    long long randomEdges = 0;
+    int updates = 100;
+    bool quiet = false;
+    for (int i = 1; i < argc; i++) {
+        if (i + 2 < argc && strcmp(argv[i], "--random") == 0) {
+            randomVertices = atoi(argv[++i]);
+            randomEdges = atoll(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--updates") == 0) {
+            updates = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--quiet") == 0) {
+            quiet = true;
+        } else {
+            cout << "Usage: " << argv[0] << " [--random n m] [--updates k] [--quiet]\n";
+            return 1;
+        }
+    }
+    if (randomVertices < 0 || randomEdges < 0 || updates < 0) {
+        cout << "Vertex, edge and update counts cannot be negative.\n";
+        return 1;
+    }
+
     // Create a graph with 6 vertices
-    Graph g(6);
-
-    // Add edges to form an undirected graph
-    g.addEdge(0, 1);
-    g.addEdge(0, 2);
-    g.addEdge(1, 3);
-    g.addEdge(2, 3);
-    g.addEdge(2, 4);
-    g.addEdge(3, 4);
-    g.addEdge(3, 5);
-    g.addEdge(4, 5);
+    int numVertices = randomVertices > 0 ? randomVertices : 6;
+    Graph g(numVertices);
+
+    if (randomVertices > 0) {
+        for (auto& e : erdosRenyiEdges<int>(randomVertices, randomEdges)) g.addEdge(e.first, e.second);
+    } else {
+        // Add edges to form an undirected graph
+        g.addEdge(0, 1);
+        g.addEdge(0, 2);
+        g.addEdge(1, 3);
+        g.addEdge(2, 3);
+        g.addEdge(2, 4);
+        g.addEdge(3, 4);
+        g.addEdge(3, 5);
+        g.addEdge(4, 5);
+    }
 
     int startVertex = 0;
+    g.build();
+
+    // Results are written only after each timed region ends
+    TraversalResult result(numVertices);
+    ResultWriter writer(cout);
 
     // Measure sequential BFS
-    cout << "Sequential BFS: ";
     auto start = chrono::high_resolution_clock::now();
-    g.sequentialBFS(startVertex);
+    g.sequentialBFS(startVertex, result);
     auto end = chrono::high_resolution_clock::now();
     double seq_bfs_time = chrono::duration<double, milli>(end - start).count();
+    if (!quiet) writer.write("Sequential BFS: ", result.order);
     cout << "Time: " << seq_bfs_time << " ms" << endl;
+    vector<int> seqDistance = result.distance;
 
     // Measure parallel BFS
-    cout << "Parallel BFS: ";
     start = chrono::high_resolution_clock::now();
-    g.parallelBFS(startVertex);
+    g.parallelBFS(startVertex, result);
     end = chrono::high_resolution_clock::now();
     double par_bfs_time = chrono::duration<double, milli>(end - start).count();
+    if (!quiet) writer.write("Parallel BFS: ", result.order);
     cout << "Time: " << par_bfs_time << " ms" << endl;
+    cout << "Distances match: " << (result.distance == seqDistance ? "Yes" : "No") << endl;
 
     // Measure sequential DFS
-    cout << "Sequential DFS: ";
     start = chrono::high_resolution_clock::now();
-    g.sequentialDFS(startVertex);
+    g.sequentialDFS(startVertex, result);
     end = chrono::high_resolution_clock::now();
     double seq_dfs_time = chrono::duration<double, milli>(end - start).count();
+    if (!quiet) writer.write("Sequential DFS: ", result.order);
     cout << "Time: " << seq_dfs_time << " ms" << endl;
+    size_t seqReached = result.order.size();
 
     // Measure parallel DFS
-    cout << "Parallel DFS: ";
     start = chrono::high_resolution_clock::now();
-    g.parallelDFS(startVertex);
+    g.parallelDFS(startVertex, result);
     end = chrono::high_resolution_clock::now();
     double par_dfs_time = chrono::duration<double, milli>(end - start).count();
+    if (!quiet) writer.write("Parallel DFS: ", result.order);
     cout << "Time: " << par_dfs_time << " ms" << endl;
+    cout << "Reached vertices match: " << (result.order.size() == seqReached ? "Yes" : "No") << endl;
 
     // Compute speedup
     cout << "Speedup (BFS): " << seq_bfs_time / par_bfs_time << endl;
@@ -251,5 +311,47 @@ int main() {
     cout << "Efficiency (BFS): " << (seq_bfs_time / par_bfs_time) / num_threads << endl;
     cout << "Efficiency (DFS): " << (seq_dfs_time / par_dfs_time) / num_threads << endl;
 
+    // Dynamic update: apply one batch, then repair the BFS instead of recomputing it
+    vector<CSRGraph<>::Edge> insertions, deletions;
+    if (randomVertices > 0) {
+        mt19937 rng(7);
+        uniform_int_distribution<int> pick(0, numVertices - 1);
+        for (int i = 0; i < updates; i++) insertions.emplace_back(pick(rng), pick(rng));
+        for (int tries = 0; (int)deletions.size() < updates && tries < 10 * updates; tries++) {
+            int u = pick(rng);
+            auto nbrs = g.neighbors(u);
+            if (nbrs.size() > 0) deletions.emplace_back(u, nbrs.begin()[rng() % nbrs.size()]);
+        }
+    } else {
+        insertions = {{0, 5}};
+        deletions = {{0, 1}, {2, 3}};
+    }
+
+    g.parallelBFS(startVertex, result);
+    start = chrono::high_resolution_clock::now();
+    g.applyBatch(insertions, deletions);
+    end = chrono::high_resolution_clock::now();
+    double batch_time = chrono::duration<double, milli>(end - start).count();
+
+    start = chrono::high_resolution_clock::now();
+    BFSRepairStats repair = g.incrementalBFS(startVertex, result, insertions, deletions);
+    end = chrono::high_resolution_clock::now();
+    double repair_time = chrono::duration<double, milli>(end - start).count();
+
+    TraversalResult fresh(numVertices);
+    start = chrono::high_resolution_clock::now();
+    g.parallelBFS(startVertex, fresh);
+    end = chrono::high_resolution_clock::now();
+    double full_time = chrono::duration<double, milli>(end - start).count();
+
+    cout << "\nUpdate batch: " << insertions.size() << " insertions, " << deletions.size() << " deletions" << endl;
+    cout << "Batch apply time: " << batch_time << " ms (" << g.graph().touchedVertices() << " vertices touched, "
+         << g.graph().compactions() << " compactions)" << endl;
+    cout << "Incremental BFS time: " << repair_time << " ms (" << (repair.recomputed ? "full recompute" : "repaired")
+         << ", " << repair.invalidated << " invalidated, " << repair.updated << " updated)" << endl;
+    cout << "Full BFS time: " << full_time << " ms" << endl;
+    cout << "Incremental distances match: " << (result.distance == fresh.distance ? "Yes" : "No") << endl;
+    if (!quiet) writer.write("Distances after update: ", result.distance);
+
     return 0;
 }
\ No newline at end of file
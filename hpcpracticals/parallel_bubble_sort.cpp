@@ -6,6 +6,7 @@
 #include <iomanip>
 #include <limits>
 #include <chrono>
+#include "odd_even_sort.h"
 
 using namespace std;
 
@@ -24,28 +25,19 @@ void bubbleSortSequential(vector<int> &arr) {
     }
 }
 
-// Parallel Bubble Sort with early termination
-void bubbleSortParallel(vector<int> &arr) {
+// Parallel Bubble Sort: block odd-even transposition (odd_even_sort.h).
+// Each thread bubble-sorts its block of n/p elements, then neighbouring
+// blocks merge-split until an odd and an even round change nothing, one
+// barrier per round instead of one per element phase. Returns the rounds
+// run (0 for the sequential path).
+int bubbleSortParallel(vector<int> &arr) {
     int n = arr.size();
     int threshold = max(100, 50 * omp_get_max_threads()); // Dynamic threshold
     if(n <= threshold) {
         bubbleSortSequential(arr);
-        return;
-    }
-    bool swapped = true;
-    #pragma omp parallel
-    {
-        for(int i = 0; i < n && swapped; ++i) {
-            swapped = false;
-            #pragma omp for reduction(||:swapped)
-            for(int j = i % 2; j < n-1; j += 2) {
-                if(arr[j] > arr[j+1]) {
-                    swap(arr[j], arr[j+1]);
-                    swapped = true;
-                }
-            }
-        }
+        return 0;
     }
+    return oddEvenMergeSplitSort(arr, [](int* first, int* last) { bubbleSortRange(first, last); });
 }
 
 // Function to validate integer input
@@ -66,12 +58,16 @@ void printTimeComplexity(int size, int threshold) {
     cout << "- Array size: " << size << ", Threshold for sequential sort: " << threshold << "\n";
     if(size <= threshold) {
         cout << "- Using sequential bubble sort\n";
+        cout << "- Best case: O(n) when array is already sorted (n = " << size << ")\n";
+        cout << "- Average/Worst case: O(n²) (n = " << size << ")\n";
     } else {
-        cout << "- Using parallel bubble sort\n";
+        int p = omp_get_max_threads();
+        cout << "- Using parallel block bubble sort (" << p << " blocks of about " << size / p << ")\n";
+        cout << "- Best case: O(n/p) per thread when array is already sorted (n = " << size << ", p = " << p << ")\n";
+        cout << "- Average/Worst case: O((n/p)² + p * n/p) per thread: bubble sort of each block, then\n";
+        cout << "  about p merge-split rounds of O(n/p), each ending in one barrier\n";
+        cout << "- Note: Total work drops from O(n²) to O(n²/p), so the speedup over one thread can exceed p.\n";
     }
-    cout << "- Best case: O(n) when array is already sorted (n = " << size << ")\n";
-    cout << "- Average/Worst case: O(n²) (n = " << size << ")\n";
-    cout << "- Note: Parallelism reduces runtime by a factor up to the number of threads, but asymptotic complexity remains the same.\n";
 }
 
 int main() {
@@ -109,12 +105,13 @@ int main() {
 
     // High-resolution timing
     auto start = chrono::high_resolution_clock::now();
-    bubbleSortParallel(arr);
+    int rounds = bubbleSortParallel(arr);
     auto end = chrono::high_resolution_clock::now();
     double time_par_bubble = chrono::duration<double>(end - start).count();
 
     cout << fixed << setprecision(6);
     cout << "Parallel Bubble Sort Time: " << time_par_bubble << " seconds\n";
+    if(rounds > 0) cout << "Merge-split rounds: " << rounds << " (" << omp_get_max_threads() << " blocks)\n";
 
     // Print sorted array for small inputs
     if(SIZE <= 10) {
@@ -159,5 +156,18 @@ Time Complexity Analysis:
 - Using sequential bubble sort
 - Best case: O(n) when array is already sorted (n = 5)
 - Average/Worst case: O(n┬▓) (n = 5)
-- Note: Parallelism reduces runtime by a factor up to the number of threads, but asymptotic complexity remains the same.
+
+Enter the size of the array (1-1000000): 20000
+Generate random array (r) or manual input (m)? r
+Parallel Bubble Sort Time: 0.123593 seconds
+Merge-split rounds: 9 (8 blocks)
+Array is sorted
+
+Time Complexity Analysis:
+- Array size: 20000, Threshold for sequential sort: 400
+- Using parallel block bubble sort (8 blocks of about 2500)
+- Best case: O(n/p) per thread when array is already sorted (n = 20000, p = 8)
+- Average/Worst case: O((n/p)² + p * n/p) per thread: bubble sort of each block, then
+  about p merge-split rounds of O(n/p), each ending in one barrier
+- Note: Total work drops from O(n²) to O(n²/p), so the speedup over one thread can exceed p.
 */
\ No newline at end of file
@@ -4,16 +4,28 @@
 #include <stack>
 #include <chrono>
 #include <atomic>
+#include <cstring>
+#include "csr_graph.h"
+#include "dfs.h"
+#include "graph_io.h"
+#include "reorder.h"
 
 using namespace std;
 
-const int MAXN = 1e5;
-vector<int> adj[MAXN + 5]; // adjacency list
-atomic<bool> visited[MAXN + 5]; // mark visited nodes
+CSRGraph<> graph; // graph in CSR form (vertices are 0-based internally)
+vector<atomic<bool>> visited; // mark visited nodes, sized from the graph
 vector<int> visitedOrder; // Store the order of visited nodes
 
+// Reset the visited flags for every vertex of g
+void resetVisited(const CSRGraph<>& g) {
+    if (visited.size() != (size_t)g.numVertices()) {
+        visited = vector<atomic<bool>>(g.numVertices());
+    }
+    for (auto& flag : visited) flag = false;
+}
+
 // Function to print time complexity analysis
-void printTimeComplexity(int n, int m) {
+void printTimeComplexity(int n, int64_t m) {
     cout << "\nTime Complexity Analysis:\n";
     cout << "Sequential DFS:\n";
     cout << "  - Time Complexity: O(V + E) = O(" << n << " + " << m << ")\n";
@@ -23,112 +35,199 @@ void printTimeComplexity(int n, int m) {
     cout << "Parallel DFS:\n";
     cout << "  - Time Complexity: O(V + E/P) in ideal case, where P is number of threads\n";
     cout << "    - Actual performance depends on thread overhead and synchronization\n";
-    cout << "    - Critical section for stack updates may reduce parallelism\n";
+    cout << "    - Work stealing keeps threads busy; only vertex claims are atomic\n";
     cout << "  - Space Complexity: O(V) = O(" << n << ") for stack and visited array\n";
     cout << "Note: V = number of vertices (" << n << "), E = number of edges (" << m << ")\n";
 }
 
 // Sequential DFS (Iterative version)
-void sequentialDFS(int start, int n) {
-    for (int i = 1; i <= n; i++) visited[i] = false;
+// Vertices are marked when popped and neighbours are pushed in reverse, so the
+// visit order and tree match the recursive DFS.
+void sequentialDFS(const CSRGraph<>& g, int start) {
+    resetVisited(g);
     visitedOrder.clear();
 
     stack<int> s;
     s.push(start);
-    visited[start] = true;
-    visitedOrder.push_back(start);
 
     while (!s.empty()) {
         int node = s.top();
         s.pop();
-
-        for (int next_node : adj[node]) {
-            if (!visited[next_node]) {
-                visited[next_node] = true;
-                visitedOrder.push_back(next_node);
-                s.push(next_node);
-            }
+        if (visited[node]) continue;
+        visited[node] = true;
+        visitedOrder.push_back(node);
+
+        auto nbrs = g.neighbors(node);
+        for (const int* it = nbrs.end(); it != nbrs.begin();) {
+            int next_node = *--it;
+            if (!visited[next_node]) s.push(next_node);
         }
     }
 }
 
-// Parallel DFS using OpenMP (Iterative version)
-void parallelDFS(int start, int n, int numThreads) {
+// Parallel DFS using OpenMP: work-stealing engine from dfs.h
+// (per-thread Chase-Lev deques, atomic CAS claims)
+DFSResult<int> parallelResult;
+void parallelDFS(const CSRGraph<>& g, int start, int numThreads) {
     omp_set_num_threads(numThreads);
-    for (int i = 1; i <= n; i++) visited[i] = false;
-    visitedOrder.clear();
+    parallelResult = workStealingDFS(g, start);
+    visitedOrder = parallelResult.order;
+}
 
-    stack<int> s;
-    s.push(start);
-    visited[start] = true;
-    visitedOrder.push_back(start);
+// Preprocessing for --reorder: relabels g for locality, replacing it and
+// mapping source to its new id, so every run after this one traverses the
+// relabelled graph. Both DFS versions are timed before and after. The
+// relabelled visit order is mapped back to input ids through the
+// permutation; neighbour order changes, so only the reached set must match.
+Relabeling<int> reorderGraph(CSRGraph<>& g, int& source, VertexOrdering ordering, int numThreads) {
+    auto start = chrono::high_resolution_clock::now();
+    sequentialDFS(g, source);
+    auto end = chrono::high_resolution_clock::now();
+    double seq_before = chrono::duration<double, milli>(end - start).count();
+    vector<char> reachedBefore(g.numVertices(), 0);
+    for (int node : visitedOrder) reachedBefore[node] = 1;
 
-    while (!s.empty()) {
-        int node = s.top();
-        s.pop();
+    start = chrono::high_resolution_clock::now();
+    parallelDFS(g, source, numThreads);
+    end = chrono::high_resolution_clock::now();
+    double par_before = chrono::duration<double, milli>(end - start).count();
+    const double gapBefore = averageEdgeGap(g);
+
+    start = chrono::high_resolution_clock::now();
+    Relabeling<int> relabel = computeOrdering(g, ordering);
+    g = relabelGraph(g, relabel);
+    end = chrono::high_resolution_clock::now();
+    double reorder_time = chrono::duration<double, milli>(end - start).count();
+    source = relabel.newId[source];
+
+    start = chrono::high_resolution_clock::now();
+    sequentialDFS(g, source);
+    end = chrono::high_resolution_clock::now();
+    double seq_after = chrono::duration<double, milli>(end - start).count();
+    vector<int> mappedOrder(visitedOrder.size());
+    for (size_t i = 0; i < visitedOrder.size(); i++) mappedOrder[i] = relabel.oldId[visitedOrder[i]];
+
+    start = chrono::high_resolution_clock::now();
+    parallelDFS(g, source, numThreads);
+    end = chrono::high_resolution_clock::now();
+    double par_after = chrono::duration<double, milli>(end - start).count();
+
+    bool correct = validateDFSForest(g, parallelResult) && parallelResult.reached == (int64_t)mappedOrder.size();
+    for (int node : mappedOrder) correct = correct && reachedBefore[node];
+
+    cout << "Reordering (" << orderingName(ordering) << "): " << reorder_time << " ms\n";
+    cout << "Average edge gap: " << gapBefore << " -> " << averageEdgeGap(g) << "\n";
+    cout << "Sequential DFS Time: " << seq_before << " ms -> " << seq_after << " ms (x"
+         << seq_before / seq_after << ")\n";
+    cout << "Parallel DFS Time: " << par_before << " ms -> " << par_after << " ms (x"
+         << par_before / par_after << ")\n";
+    cout << "Reordered Correctness: " << (correct ? "Pass" : "Fail") << "\n";
+    cout << "Runs below use the relabelled graph\n\n";
+    return relabel;
+}
 
-        // Parallelizing the processing of neighbors
-        #pragma omp parallel for
-        for (int i = 0; i < adj[node].size(); i++) {
-            int next_node = adj[node][i];
-            if (!visited[next_node]) {
-                visited[next_node] = true;
-                #pragma omp critical
-                {
-                    visitedOrder.push_back(next_node);
-                    s.push(next_node);
-                }
+int main(int argc, char* argv[]) {
+    // Non-interactive mode: --graph <file> --source <s> --threads <t> [--load-only] [--dedup] [--save-binary <out.bin>]
+    // Locality relabelling: --reorder degree|rcm|bfs
+    GraphOptions options;
+    VertexOrdering ordering = VertexOrdering::Original;
+    for (int i = 1; i < argc; i++) {
+        if (parseGraphOption(argc, argv, i, options)) continue;
+        if (i + 1 < argc && strcmp(argv[i], "--reorder") == 0) {
+            try {
+                ordering = parseOrdering(argv[++i]);
+            } catch (const exception& e) {
+                cout << e.what() << "\n";
+                return 1;
             }
+        } else {
+            cout << "Usage: " << argv[0] << " [--graph file --source s --threads t] [--load-only]"
+                 << " [--dedup] [--save-binary out.bin] [--reorder degree|rcm|bfs]\n";
+            return 1;
         }
     }
-}
 
-int main() {
-    int n, m, start_node, numThreads;
-    cout << "Enter number of nodes, edges, and threads: ";
-    cin >> n >> m >> numThreads;
-    cout << "Enter start node: ";
-    cin >> start_node;
+    int n, numThreads;
+    int64_t m;
+    long long start_node;
+    int base; // Numbering used for input/output vertex ids
+    vector<CSRGraph<>::Edge> edges;
+
+    if (options.graphFile.empty()) {
+        cout << "Enter number of nodes, edges, and threads: ";
+        cin >> n >> m >> numThreads;
+        cout << "Enter start node: ";
+        cin >> start_node;
+        base = 1;
+
+        // Input validation
+        if (n < 1) {
+            cout << "Number of nodes must be at least 1.\n";
+            return 1;
+        }
+        if (m < 0) {
+            cout << "Number of edges cannot be negative.\n";
+            return 1;
+        }
 
-    // Input validation
-    if (n < 1 || n > MAXN) {
-        cout << "Number of nodes must be between 1 and " << MAXN << ".\n";
-        return 1;
-    }
-    if (m < 0) {
-        cout << "Number of edges cannot be negative.\n";
-        return 1;
+        // Input edges (1-based on input, stored 0-based)
+        edges.reserve(m);
+        cout << "Enter " << m << " edges (format: u v):\n";
+        for (int64_t i = 0; i < m; i++) {
+            int u, v;
+            cin >> u >> v;
+            if (u < 1 || u > n || v < 1 || v > n) {
+                cout << "Invalid edge (" << u << ", " << v << "). Vertices must be between 1 and " << n << ".\n";
+                return 1;
+            }
+            edges.emplace_back(u - 1, v - 1);
+        }
+    } else {
+        if (!loadGraphEdges(options, edges, n, base)) return 1;
+        if (n < 1) {
+            cout << "Graph has no vertices.\n";
+            return 1;
+        }
+        m = (int64_t)edges.size();
+        start_node = options.source;
+        numThreads = options.threads > 0 ? options.threads : omp_get_max_threads();
     }
-    if (start_node < 1 || start_node > n) {
-        cout << "Start node must be between 1 and " << n << ".\n";
+
+    if (start_node < base || start_node >= (long long)n + base) {
+        cout << "Start node must be between " << base << " and " << (long long)n + base - 1 << ".\n";
         return 1;
     }
     if (numThreads < 1) {
         cout << "Number of threads must be at least 1.\n";
         return 1;
     }
-
-    // Clear adjacency list
-    for (int i = 1; i <= n; i++) {
-        adj[i].clear();
+    int source = (int)(start_node - base);
+
+    // Typed-in graphs keep their input neighbour order; file graphs use the parallel builder
+    auto buildStart = chrono::high_resolution_clock::now();
+    if (options.graphFile.empty()) {
+        graph = CSRGraph<>::fromEdges(n, edges);
+    } else {
+        CSRBuildOptions buildOptions;
+        buildOptions.removeSelfLoops = buildOptions.removeDuplicates = options.dedup;
+        graph = CSRGraph<>::fromEdgesParallel(n, edges, buildOptions);
     }
-
-    // Input edges
-    cout << "Enter " << m << " edges (format: u v):\n";
-    for (int i = 0; i < m; i++) {
-        int u, v;
-        cin >> u >> v;
-        if (u < 1 || u > n || v < 1 || v > n) {
-            cout << "Invalid edge (" << u << ", " << v << "). Vertices must be between 1 and " << n << ".\n";
-            return 1;
-        }
-        adj[u].push_back(v);
-        adj[v].push_back(u);
+    auto buildEnd = chrono::high_resolution_clock::now();
+    edges = vector<CSRGraph<>::Edge>();
+    if (!options.graphFile.empty()) {
+        cout << "CSR Build Time: " << chrono::duration<double, milli>(buildEnd - buildStart).count() << " ms ("
+             << graph.numArcs() << " arcs)\n";
+        if (options.loadOnly) return 0;
     }
 
+    // Optional relabelling; printed vertex ids are mapped back to the input's
+    Relabeling<int> relabel;
+    if (ordering != VertexOrdering::Original) relabel = reorderGraph(graph, source, ordering, numThreads);
+    auto inputId = [&](int v) { return (relabel.oldId.empty() ? v : relabel.oldId[v]) + base; };
+
     // Sequential DFS
     auto start = chrono::high_resolution_clock::now();
-    sequentialDFS(start_node, n);
+    sequentialDFS(graph, source);
     auto end = chrono::high_resolution_clock::now();
     double seq_time = chrono::duration<double, milli>(end - start).count();
 
@@ -136,20 +235,16 @@ int main() {
 
     // Parallel DFS
     start = chrono::high_resolution_clock::now();
-    parallelDFS(start_node, n, numThreads);
+    parallelDFS(graph, source, numThreads);
     end = chrono::high_resolution_clock::now();
     double par_time = chrono::duration<double, milli>(end - start).count();
 
-    // Verify correctness
-    bool correct = (seqVisitedOrder.size() == visitedOrder.size());
-    if (correct) {
-        for (size_t i = 0; i < seqVisitedOrder.size(); i++) {
-            if (seqVisitedOrder[i] != visitedOrder[i]) {
-                correct = false;
-                break;
-            }
-        }
-    }
+    // Verify correctness: same reachable set and a well-formed DFS forest
+    bool correct = (seqVisitedOrder.size() == visitedOrder.size()) &&
+                   validateDFSForest(graph, parallelResult);
+
+    // Stolen subtrees run concurrently, so the order only matches the sequential one on a single thread
+    bool sameOrder = (seqVisitedOrder == visitedOrder);
 
     // Print performance metrics
     cout << "Sequential DFS Time: " << seq_time << " ms\n";
@@ -158,13 +253,19 @@ int main() {
     cout << "Threads Used: " << numThreads << "\n";
     cout << "Efficiency: " << (seq_time / par_time) / numThreads << "\n";
     cout << "Correctness: " << (correct ? "Pass" : "Fail") << "\n";
-
-    // Print visited nodes
-    cout << "Visited nodes: ";
-    for (int node : visitedOrder) {
-        cout << node << " ";
+    cout << "Visit order matches sequential: " << (sameOrder ? "Yes" : "No") << "\n";
+    cout << "Steals: " << parallelResult.steals << ", Cross edges: " << countCrossEdges(graph, parallelResult) << "\n";
+
+    // Print visited nodes (typed-in graphs only; file graphs can have millions)
+    if (options.graphFile.empty()) {
+        cout << "Visited nodes: ";
+        for (int node : visitedOrder) {
+            cout << inputId(node) << " ";
+        }
+        cout << "\n";
+    } else {
+        cout << "Visited nodes: " << visitedOrder.size() << "\n";
     }
-    cout << "\n";
 
     // Print time complexity
     printTimeComplexity(n, m);
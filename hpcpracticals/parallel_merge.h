@@ -0,0 +1,117 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <omp.h>
+
+// Merge-path (co-ranking) merge of two sorted runs, split into output slices
+// of equal length that are merged independently by OpenMP tasks.
+
+// Co-rank of output position k: returns how many of the first k merged
+// elements come from a (the rest, k - i, come from b). Ties take a first, so
+// the merge is stable. Binary search over the diagonal i + j = k.
+template <typename T, typename Less>
+int64_t mergePathSplit(const T* a, int64_t n1, const T* b, int64_t n2, int64_t k, Less less) {
+    int64_t lo = std::max<int64_t>(0, k - n2), hi = std::min(k, n1);
+    while (lo < hi) {
+        int64_t i = lo + (hi - lo) / 2;
+        if (!less(b[k - i - 1], a[i])) lo = i + 1; // a[i] <= b[j - 1]: a[i] is among the first k
+        else hi = i;
+    }
+    return lo;
+}
+
+// Serial stable merge of a[0, n1) and b[0, n2) into out. Arithmetic keys
+// take the branchless loop: the comparison result selects the value and
+// advances the indices arithmetically, which compiles to conditional moves
+// instead of a branch that mispredicts on random input.
+template <typename T, typename Less>
+void mergeRuns(const T* a, int64_t n1, const T* b, int64_t n2, T* out, Less less) {
+    int64_t i = 0, j = 0;
+    if (std::is_arithmetic<T>::value) {
+        while (i < n1 && j < n2) {
+            const T x = a[i], y = b[j];
+            const bool takeB = less(y, x);
+            *out++ = takeB ? y : x;
+            j += takeB;
+            i += !takeB;
+        }
+    }
+    while (i < n1 && j < n2) *out++ = less(b[j], a[i]) ? b[j++] : a[i++];
+    out = std::copy(a + i, a + n1, out);
+    std::copy(b + j, b + n2, out);
+}
+
+// mergeRuns over parallel key and value arrays: values move with their keys,
+// so keys are never zipped into pairs with their values
+template <typename K, typename V, typename Less>
+void mergeRunsByKey(const K* ka, const V* va, int64_t n1, const K* kb, const V* vb, int64_t n2, K* kout, V* vout,
+                    Less less) {
+    int64_t i = 0, j = 0;
+    while (i < n1 && j < n2) {
+        if (less(kb[j], ka[i])) {
+            *kout++ = kb[j];
+            *vout++ = vb[j++];
+        } else {
+            *kout++ = ka[i];
+            *vout++ = va[i++];
+        }
+    }
+    kout = std::copy(ka + i, ka + n1, kout);
+    vout = std::copy(va + i, va + n1, vout);
+    std::copy(kb + j, kb + n2, kout);
+    std::copy(vb + j, vb + n2, vout);
+}
+
+// Merges a[0, n1) and b[0, n2) into out using `slices` tasks: slice s writes
+// out[s * len / slices, (s + 1) * len / slices) after co-ranking both of its
+// ends, so every task does the same amount of work however the keys fall.
+// Call from inside a parallel region (e.g. under `omp single`); out must not
+// overlap the inputs.
+template <typename T, typename Less>
+void parallelMerge(const T* a, int64_t n1, const T* b, int64_t n2, T* out, int slices, Less less) {
+    const int64_t total = n1 + n2;
+    if (slices <= 1 || total < 2) {
+        mergeRuns(a, n1, b, n2, out, less);
+        return;
+    }
+    for (int s = 0; s < slices; s++) {
+        #pragma omp task firstprivate(s)
+        {
+            const int64_t k0 = total * s / slices, k1 = total * (s + 1) / slices;
+            const int64_t i0 = mergePathSplit(a, n1, b, n2, k0, less);
+            const int64_t i1 = mergePathSplit(a, n1, b, n2, k1, less);
+            mergeRuns(a + i0, i1 - i0, b + (k0 - i0), (k1 - i1) - (k0 - i0), out + k0, less);
+        }
+    }
+    #pragma omp taskwait
+}
+
+// parallelMerge over parallel key and value arrays; the slices are co-ranked
+// on the keys alone
+template <typename K, typename V, typename Less>
+void parallelMergeByKey(const K* ka, const V* va, int64_t n1, const K* kb, const V* vb, int64_t n2, K* kout, V* vout,
+                        int slices, Less less) {
+    const int64_t total = n1 + n2;
+    if (slices <= 1 || total < 2) {
+        mergeRunsByKey(ka, va, n1, kb, vb, n2, kout, vout, less);
+        return;
+    }
+    for (int s = 0; s < slices; s++) {
+        #pragma omp task firstprivate(s)
+        {
+            const int64_t k0 = total * s / slices, k1 = total * (s + 1) / slices;
+            const int64_t i0 = mergePathSplit(ka, n1, kb, n2, k0, less);
+            const int64_t i1 = mergePathSplit(ka, n1, kb, n2, k1, less);
+            mergeRunsByKey(ka + i0, va + i0, i1 - i0, kb + (k0 - i0), vb + (k0 - i0), (k1 - i1) - (k0 - i0),
+                           kout + k0, vout + k0, less);
+        }
+    }
+    #pragma omp taskwait
+}
+
+template <typename T>
+void parallelMerge(const T* a, int64_t n1, const T* b, int64_t n2, T* out, int slices) {
+    parallelMerge(a, n1, b, n2, out, slices, [](const T& x, const T& y) { return x < y; });
+}
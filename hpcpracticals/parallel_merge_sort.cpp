@@ -6,11 +6,28 @@
 #include <iomanip>
 #include <limits>
 #include <chrono>
+#include <algorithm>
+#include "parallel_merge.h"
+#include "radix_sort.h"
+#include "sample_sort.h"
+#include "simd_sort.h"
+#include "pingpong_merge_sort.h"
+#include "natural_merge_sort.h"
+#include "alloc_counter.h"
 
 using namespace std;
 
+// Base case for subarrays of up to kSimdLeaf elements: bitonic networks and
+// vectorized merges (simd_sort.h), chosen once from the CPU features. On the
+// scalar level the recursion runs down to single elements as before.
+const SimdLevel leafLevel = detectSimdLevel();
+
 // Sequential Merge Sort for small arrays
 void mergeSortSequential(vector<int>& arr, int left, int right, vector<int>& temp) {
+    if(leafLevel != SimdLevel::Scalar && right - left + 1 <= kSimdLeaf) {
+        simdSortSmall(&arr[left], right - left + 1, leafLevel);
+        return;
+    }
     if(left < right) {
         int mid = left + (right - left) / 2; // Avoid overflow
         mergeSortSequential(arr, left, mid, temp);
@@ -29,38 +46,76 @@ void mergeSortSequential(vector<int>& arr, int left, int right, vector<int>& tem
     }
 }
 
+// Task recursion depth for a team of `threads`: about four leaf tasks per
+// thread for load balance, and no tasks at all when running on one thread
+int maxTaskDepth(int threads) {
+    if(threads <= 1) return 0;
+    int depth = 2;
+    while((1 << depth) < 4 * threads) depth++;
+    return depth;
+}
+
+// Merge arr[left..mid] and arr[mid+1..right]. Large merges are split into
+// equal output slices by merge-path co-ranking (parallel_merge.h), merged
+// into temp by one task each and copied back slice by slice.
+void mergeHalves(vector<int>& arr, int left, int mid, int right, vector<int>& temp) {
+    const int min_slice = 8192; // Smallest output slice worth a task
+    const int n = right - left + 1;
+    const int slices = min(omp_get_num_threads(), n / min_slice);
+
+    if(slices <= 1) {
+        // Merge using temporary array
+        int n1 = mid - left + 1;
+        for(int i = 0; i < n1; ++i) temp[left + i] = arr[left + i];
+
+        int i = 0, j = mid + 1, k = left;
+        while(i < n1 && j <= right) {
+            arr[k++] = (temp[left + i] <= arr[j]) ? temp[left + i++] : arr[j++];
+        }
+        while(i < n1) arr[k++] = temp[left + i++];
+        return;
+    }
+
+    parallelMerge(&arr[left], mid - left + 1, &arr[mid + 1], right - mid, &temp[left], slices);
+    for(int s = 0; s < slices; ++s) {
+        #pragma omp task shared(arr, temp) firstprivate(s)
+        copy(temp.begin() + left + (long long)n * s / slices, temp.begin() + left + (long long)n * (s + 1) / slices,
+             arr.begin() + left + (long long)n * s / slices);
+    }
+    #pragma omp taskwait
+}
+
 // Parallel Merge Sort with tasks
 void mergeSortParallel(vector<int>& arr, int left, int right, vector<int>& temp, int depth = 0) {
     const int threshold = 1000; // Threshold for sequential sort
-    const int max_depth = 4;   // Limit task recursion depth
-    
+    const int max_depth = maxTaskDepth(omp_get_num_threads()); // Limit task recursion depth
+
     if(right - left + 1 <= threshold || depth >= max_depth) {
         mergeSortSequential(arr, left, right, temp);
         return;
     }
-    
+
     if(left < right) {
         int mid = left + (right - left) / 2;
-        #pragma omp task if(depth < max_depth)
+        #pragma omp task shared(arr, temp) if(depth < max_depth)
         mergeSortParallel(arr, left, mid, temp, depth + 1);
-        #pragma omp task if(depth < max_depth)
+        #pragma omp task shared(arr, temp) if(depth < max_depth)
         mergeSortParallel(arr, mid + 1, right, temp, depth + 1);
         #pragma omp taskwait
-        
-        // Merge using temporary array
-        int n1 = mid - left + 1;
-        int n2 = right - mid;
-        for(int i = 0; i < n1; ++i) temp[left + i] = arr[left + i];
-        
-        int i = 0, j = mid + 1, k = left;
-        while(i < n1 && j <= right) {
-            arr[k++] = (temp[left + i] <= arr[j]) ? temp[left + i++] : arr[j++];
-        }
- 
-        while(i < n1) arr[k++] = temp[left + i++];
+
+        mergeHalves(arr, left, mid, right, temp);
     }
 }
 
+// Bytes mergeSortSequential writes for n elements: each merge first copies
+// its left half into temp, then writes every element back into arr
+long long copyBackBytes(long long n) {
+    const long long leaf = leafLevel != SimdLevel::Scalar ? kSimdLeaf : 1;
+    if(n <= leaf) return 0;
+    long long n1 = (n + 1) / 2;
+    return copyBackBytes(n1) + copyBackBytes(n - n1) + (n1 + n) * (long long)sizeof(int);
+}
+
 // Function to validate integer input
 int getValidInteger(const string& prompt, int minVal, int maxVal) {
     int value;
@@ -78,21 +133,28 @@ void printTimeComplexity() {
     cout << "\nTime Complexity Analysis:\n";
     cout << "- Sequential Merge Sort: O(n log n) for all cases\n";
     cout << "- Parallel Merge Sort: O(n log n) total work, O((n log n)/p) wall-clock time\n";
+    cout << "  (merges are split across threads too, so the top merge costs O(n/p + log n))\n";
     cout << "  where n is the array size and p is the number of processors\n";
+    cout << "- Parallel Radix Sort: O(k n) total work, O(k n/p) wall-clock time for k byte passes\n";
+    cout << "  (k <= 4 for int keys; bytes that are equal in every key are skipped)\n";
+    cout << "- Parallel Sample Sort: O(n log n) total work in two passes over memory plus the bucket sorts\n";
+    cout << "- Ping-Pong Merge Sort: O(n log n), writing n elements per level instead of 1.5n\n";
+    cout << "- Adaptive Merge Sort: O(n + n log r) for r existing runs, so O(n) on sorted input\n";
 }
 
 int main() {
     // Get array size from user
-    int SIZE = getValidInteger("Enter the size of the array (1-1000000): ", 1, 1000000);
+    int SIZE = getValidInteger("Enter the size of the array (1-500000000): ", 1, 500000000);
     vector<int> arr(SIZE);
     vector<int> temp(SIZE); // Temporary array for merging
 
     // Get input method (random or manual)
     char inputMethod;
-    cout << "Generate random array (r) or manual input (m)? ";
+    cout << "Generate random array (r), nearly sorted array (s) or manual input (m)? ";
     cin >> inputMethod;
-    while(inputMethod != 'r' && inputMethod != 'R' && inputMethod != 'm' && inputMethod != 'M') {
-        cout << "Invalid choice. Enter 'r' for random or 'm' for manual: ";
+    while(inputMethod != 'r' && inputMethod != 'R' && inputMethod != 's' && inputMethod != 'S' &&
+          inputMethod != 'm' && inputMethod != 'M') {
+        cout << "Invalid choice. Enter 'r' for random, 's' for nearly sorted or 'm' for manual: ";
         cin >> inputMethod;
     }
 
@@ -101,6 +163,12 @@ int main() {
         for(int i = 0; i < SIZE; ++i) {
             arr[i] = rand() % 100000;
         }
+    } else if(inputMethod == 's' || inputMethod == 'S') {
+        // Time-ordered log: ascending timestamps, about 1% of them arriving late
+        srand(time(0));
+        for(int i = 0; i < SIZE; ++i) {
+            arr[i] = (rand() % 100 == 0) ? max(0, i - rand() % 1000) : i;
+        }
     } else {
         cout << "Enter " << SIZE << " integers:\n";
         for(int i = 0; i < SIZE; ++i) {
@@ -112,18 +180,84 @@ int main() {
         }
     }
 
-    // High-resolution timing
+    // Choose the parallel algorithm
+    int algorithm = getValidInteger("Choose algorithm (1 = merge sort, 2 = radix sort, 3 = sample sort, 4 = ping-pong merge sort, "
+                                    "5 = adaptive merge sort): ", 1, 5);
+
+    // Sequential baseline on a copy
+    vector<int> seqArr = arr;
     auto start = chrono::high_resolution_clock::now();
-    #pragma omp parallel
-    {
-        #pragma omp single
-        mergeSortParallel(arr, 0, SIZE - 1, temp);
-    }
+    mergeSortSequential(seqArr, 0, SIZE - 1, temp);
     auto end = chrono::high_resolution_clock::now();
-    double time_par_merge = chrono::duration<double>(end - start).count();
+    double time_seq_merge = chrono::duration<double>(end - start).count();
+
+    // The ping-pong sort takes its scratch from an arena sized up front
+    MergeSortArena<int> arena;
+    SortTraffic arenaSetup, traffic;
+    NaturalSortStats runStats;
+    if(algorithm == 4) {
+        arena.reserve(SIZE);
+        arenaSetup = arena.takeTraffic();
+    }
+
+    // High-resolution timing (temp doubles as the radix / sample sort scatter buffer)
+    int radixPasses = 0;
+    AllocSnapshot before = allocSnapshot();
+    start = chrono::high_resolution_clock::now();
+    if(algorithm == 1) {
+        #pragma omp parallel
+        {
+            #pragma omp single
+            mergeSortParallel(arr, 0, SIZE - 1, temp);
+        }
+    } else if(algorithm == 2) {
+        radixPasses = radixSortParallel(arr.data(), arr.size(), temp.data());
+    } else if(algorithm == 3) {
+        sampleSortParallel(arr.data(), arr.size(), temp.data(), [](int a, int b) { return a < b; });
+    } else if(algorithm == 5) {
+        runStats = naturalMergeSortParallel(arr.data(), arr.size(), temp.data());
+    } else if(leafLevel != SimdLevel::Scalar) {
+        traffic = pingPongMergeSort(arr.data(), arr.size(), arena, less<int>(),
+                                    [](int* leaf, size_t count) { simdSortSmall(leaf, (int)count, leafLevel); },
+                                    kSimdLeaf);
+    } else {
+        traffic = pingPongMergeSort(arr.data(), arr.size(), arena);
+    }
+    end = chrono::high_resolution_clock::now();
+    AllocSnapshot heapUsed = allocSnapshot() - before;
+    double time_par = chrono::duration<double>(end - start).count();
 
     cout << fixed << setprecision(6);
-    cout << "Parallel Merge Sort Time: " << time_par_merge << " seconds\n";
+    cout << "Base Case: " << simdLevelName(leafLevel) << " (set SIMD_SORT=scalar or avx2 to compare)\n";
+    cout << "Sequential Merge Sort Time: " << time_seq_merge << " seconds\n";
+    if(algorithm == 1) {
+        cout << "Parallel Merge Sort Time: " << time_par << " seconds\n";
+        cout << "Speedup: " << time_seq_merge / time_par << " (" << omp_get_max_threads() << " threads, task depth "
+             << maxTaskDepth(omp_get_max_threads()) << ")\n";
+    } else if(algorithm == 2) {
+        cout << "Parallel Radix Sort Time: " << time_par << " seconds\n";
+        cout << "Speedup: " << time_seq_merge / time_par << " (" << omp_get_max_threads() << " threads, "
+             << radixPasses << " of 4 byte passes)\n";
+    } else if(algorithm == 3) {
+        cout << "Parallel Sample Sort Time: " << time_par << " seconds\n";
+        cout << "Speedup: " << time_seq_merge / time_par << " (" << omp_get_max_threads()
+             << " threads, 4 buckets per thread)\n";
+    } else if(algorithm == 5) {
+        cout << "Adaptive Merge Sort Time: " << time_par << " seconds\n";
+        cout << "Speedup: " << time_seq_merge / time_par << " (" << omp_get_max_threads() << " threads)\n";
+        cout << "Runs: " << runStats.runs << " (" << runStats.reversed << " descending runs reversed), "
+             << runStats.merges << " merges, " << runStats.skippedMerges << " already in order\n";
+        cout << "Elements merged: " << runStats.mergedElements << " ("
+             << (double)runStats.mergedElements / SIZE << " per element)\n";
+    } else {
+        cout << "Ping-Pong Merge Sort Time: " << time_par << " seconds\n";
+        cout << "Speedup: " << time_seq_merge / time_par << " (" << omp_get_max_threads() << " threads, "
+             << traffic.levels << " merge levels)\n";
+        cout << "Arena: " << arenaSetup.allocations << " allocations (" << arenaSetup.bytesAllocated
+             << " bytes) at setup, " << traffic.allocations << " during the sort\n";
+        cout << "Heap allocations during the sort: " << heapUsed.allocations << " (" << heapUsed.bytes << " bytes)\n";
+        cout << "Bytes moved: " << traffic.bytesMoved << " (copy-back merge sort: " << copyBackBytes(SIZE) << ")\n";
+    }
 
     // Print sorted array for small inputs
     if(SIZE <= 10) {
@@ -144,6 +278,7 @@ int main() {
         }
     }
     cout << (isSorted ? "Array is sorted\n" : "Array is not sorted\n");
+    cout << (arr == seqArr ? "Matches sequential result\n" : "Does not match sequential result\n");
 
     // Print time complexity
     printTimeComplexity();
@@ -152,20 +287,58 @@ int main() {
 }
 
 /*$ ./parallel_merge_sort.exe
-Enter the size of the array (1-1000000): 5
-Generate random array (r) or manual input (m)? m
+Enter the size of the array (1-500000000): 5
+Generate random array (r), nearly sorted array (s) or manual input (m)? m
 Enter 5 integers:
 5
 2
 9
 1
 6
-Parallel Merge Sort Time: 0.002983 seconds
+Choose algorithm (1 = merge sort, 2 = radix sort, 3 = sample sort, 4 = ping-pong merge sort, 5 = adaptive merge sort): 4
+Base Case: AVX-512 (set SIMD_SORT=scalar or avx2 to compare)
+Sequential Merge Sort Time: 0.000001 seconds
+Ping-Pong Merge Sort Time: 0.000010 seconds
+Speedup: 0.138589 (1 threads, 0 merge levels)
+Arena: 2 allocations (84 bytes) at setup, 0 during the sort
+Heap allocations during the sort: 0 (0 bytes)
+Bytes moved: 0 (copy-back merge sort: 0)
 Sorted array: [1, 2, 5, 6, 9]
 Array is sorted
+Matches sequential result
+
+Time Complexity Analysis:
+- Sequential Merge Sort: O(n log n) for all cases
+- Parallel Merge Sort: O(n log n) total work, O((n log n)/p) wall-clock time
+  (merges are split across threads too, so the top merge costs O(n/p + log n))
+  where n is the array size and p is the number of processors
+- Parallel Radix Sort: O(k n) total work, O(k n/p) wall-clock time for k byte passes
+  (k <= 4 for int keys; bytes that are equal in every key are skipped)
+- Parallel Sample Sort: O(n log n) total work in two passes over memory plus the bucket sorts
+- Ping-Pong Merge Sort: O(n log n), writing n elements per level instead of 1.5n
+- Adaptive Merge Sort: O(n + n log r) for r existing runs, so O(n) on sorted input
+
+$ ./parallel_merge_sort.exe
+Enter the size of the array (1-500000000): 1000000
+Generate random array (r), nearly sorted array (s) or manual input (m)? s
+Choose algorithm (1 = merge sort, 2 = radix sort, 3 = sample sort, 4 = ping-pong merge sort, 5 = adaptive merge sort): 5
+Base Case: AVX-512 (set SIMD_SORT=scalar or avx2 to compare)
+Sequential Merge Sort Time: 0.018575 seconds
+Adaptive Merge Sort Time: 0.010233 seconds
+Speedup: 1.815153 (1 threads)
+Runs: 7660 (67 descending runs reversed), 7659 merges, 0 already in order
+Elements merged: 2000763 (2.000763 per element)
+Array is sorted
+Matches sequential result
 
 Time Complexity Analysis:
 - Sequential Merge Sort: O(n log n) for all cases
 - Parallel Merge Sort: O(n log n) total work, O((n log n)/p) wall-clock time
+  (merges are split across threads too, so the top merge costs O(n/p + log n))
   where n is the array size and p is the number of processors
+- Parallel Radix Sort: O(k n) total work, O(k n/p) wall-clock time for k byte passes
+  (k <= 4 for int keys; bytes that are equal in every key are skipped)
+- Parallel Sample Sort: O(n log n) total work in two passes over memory plus the bucket sorts
+- Ping-Pong Merge Sort: O(n log n), writing n elements per level instead of 1.5n
+- Adaptive Merge Sort: O(n + n log r) for r existing runs, so O(n) on sorted input
 */
\ No newline at end of file
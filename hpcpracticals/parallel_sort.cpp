@@ -5,6 +5,10 @@
 #include <ctime>
 #include <iomanip>
 #include <algorithm>  // Added for min_element
+#include "sample_sort.h"
+#include "pingpong_merge_sort.h"
+#include "alloc_counter.h"
+#include "odd_even_sort.h"
 
 using namespace std;
 
@@ -17,16 +21,11 @@ void bubbleSortSequential(vector<int> &arr) {
                 swap(arr[j], arr[j+1]);
 }
 
-// Parallel Bubble Sort
-void bubbleSortParallel(vector<int> &arr) {
-    int n = arr.size();
-    for(int i = 0; i < n; ++i) {
-        #pragma omp parallel for
-        for(int j = i % 2; j < n-1; j += 2) {
-            if(arr[j] > arr[j+1])
-                swap(arr[j], arr[j+1]);
-        }
-    }
+// Parallel Bubble Sort: block odd-even transposition (odd_even_sort.h).
+// Each thread bubble-sorts its n/p block, then neighbouring blocks
+// merge-split in about p rounds, one barrier each, instead of n fork/joins.
+int bubbleSortParallel(vector<int> &arr) {
+    return oddEvenMergeSplitSort(arr, [](int* first, int* last) { bubbleSortRange(first, last); });
 }
 
 // Merge utility
@@ -71,15 +70,15 @@ void mergeSortParallel(vector<int>& arr, int left, int right) {
 
 int main() {
     const int SIZE = 10000;
-    vector<int> arr1(SIZE), arr2(SIZE), arr3(SIZE), arr4(SIZE);
+    vector<int> arr1(SIZE), arr2(SIZE), arr3(SIZE), arr4(SIZE), arr5(SIZE), arr6(SIZE);
 
     srand(time(0));
     for(int i = 0; i < SIZE; ++i) {
         int val = rand() % 100000;
-        arr1[i] = arr2[i] = arr3[i] = arr4[i] = val;
+        arr1[i] = arr2[i] = arr3[i] = arr4[i] = arr5[i] = arr6[i] = val;
     }
 
-    double t1, t2, time_seq_bubble, time_par_bubble, time_seq_merge, time_par_merge;
+    double t1, t2, time_seq_bubble, time_par_bubble, time_seq_merge, time_par_merge, time_par_sample, time_pingpong;
 
     t1 = omp_get_wtime();
     bubbleSortSequential(arr1);
@@ -89,16 +88,21 @@ int main() {
     cout << "Sequential Bubble Sort Time: " << time_seq_bubble << " seconds\n";
 
     t1 = omp_get_wtime();
-    bubbleSortParallel(arr2);
+    int rounds = bubbleSortParallel(arr2);
     t2 = omp_get_wtime();
     time_par_bubble = t2 - t1;
-    cout << "Parallel Bubble Sort Time:   " << time_par_bubble << " seconds\n";
+    cout << "Parallel Bubble Sort Time:   " << time_par_bubble << " seconds (" << omp_get_max_threads()
+         << " blocks, " << rounds << " merge-split rounds)\n";
+    cout << "Parallel Bubble Sort matches Sequential: " << (arr2 == arr1 ? "Yes" : "No") << "\n";
 
+    AllocSnapshot before = allocSnapshot();
     t1 = omp_get_wtime();
     mergeSortSequential(arr3, 0, SIZE - 1);
     t2 = omp_get_wtime();
+    AllocSnapshot mergeAllocs = allocSnapshot() - before;
     time_seq_merge = t2 - t1;
-    cout << "Sequential Merge Sort Time: " << time_seq_merge << " seconds\n";
+    cout << "Sequential Merge Sort Time: " << time_seq_merge << " seconds (" << mergeAllocs.allocations
+         << " heap allocations)\n";
 
     t1 = omp_get_wtime();
     mergeSortParallel(arr4, 0, SIZE - 1);
@@ -106,6 +110,28 @@ int main() {
     time_par_merge = t2 - t1;
     cout << "Parallel Merge Sort Time:   " << time_par_merge << " seconds\n";
 
+    // Samplesort: one classification pass instead of log2(n) merge levels
+    vector<int> buffer(SIZE);
+    t1 = omp_get_wtime();
+    sampleSortParallel(arr5.data(), SIZE, buffer.data(), [](int a, int b) { return a < b; }, 1000);
+    t2 = omp_get_wtime();
+    time_par_sample = t2 - t1;
+    cout << "Parallel Sample Sort Time:  " << time_par_sample << " seconds\n";
+    cout << "Sample Sort matches Merge Sort: " << (arr5 == arr3 ? "Yes" : "No") << "\n";
+
+    // Ping-pong merge sort: scratch comes from the arena, merges alternate direction
+    MergeSortArena<int> arena(SIZE);
+    arena.takeTraffic(); // Leave the arena setup out of the sort's count
+    before = allocSnapshot();
+    t1 = omp_get_wtime();
+    SortTraffic traffic = pingPongMergeSort(arr6.data(), SIZE, arena);
+    t2 = omp_get_wtime();
+    AllocSnapshot pingPongAllocs = allocSnapshot() - before;
+    time_pingpong = t2 - t1;
+    cout << "Ping-Pong Merge Sort Time:  " << time_pingpong << " seconds (" << pingPongAllocs.allocations
+         << " heap allocations, " << traffic.bytesMoved / 1024 << " KiB moved)\n";
+    cout << "Ping-Pong Sort matches Merge Sort: " << (arr6 == arr3 ? "Yes" : "No") << "\n";
+
     cout << "\nEfficiency Summary:\n";
 
     if (time_seq_bubble < time_par_bubble)
@@ -120,7 +146,7 @@ int main() {
 
     cout << "\nBest Performer Overall: ";
     // Create a vector from the initializer list
-    vector<double> times = {time_seq_bubble, time_par_bubble, time_seq_merge, time_par_merge};
+    vector<double> times = {time_seq_bubble, time_par_bubble, time_seq_merge, time_par_merge, time_par_sample, time_pingpong};
     // Use min_element to find the minimum time
     double min_time = *min_element(times.begin(), times.end());
     
@@ -128,6 +154,10 @@ int main() {
         cout << "Sequential Merge Sort \n";
     else if (min_time == time_par_merge)
         cout << "Parallel Merge Sort \n";
+    else if (min_time == time_par_sample)
+        cout << "Parallel Sample Sort \n";
+    else if (min_time == time_pingpong)
+        cout << "Ping-Pong Merge Sort \n";
     else if (min_time == time_seq_bubble)
         cout << "Sequential Bubble Sort \n";
     else
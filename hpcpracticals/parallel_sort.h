@@ -0,0 +1,231 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <omp.h>
+#include "parallel_merge.h"
+#include "radix_sort.h"
+
+// Generic parallel sort for any element type, header-only:
+//   parallelSort(first, last[, comp[, proj]])
+//   parallelSortByKey(keysFirst, keysLast, valuesFirst[, comp])
+// Both are stable. The path is picked at compile time: ascending order
+// (std::less) on a 32/64-bit integer or floating-point key uses the LSD radix
+// sort, anything else a parallel bottom-up merge sort whose merges are
+// split by merge path and run branchless for arithmetic elements.
+
+// Projection that returns the element itself
+struct IdentityProjection {
+    template <typename T>
+    const T& operator()(const T& x) const { return x; }
+};
+
+namespace parallel_sort_detail {
+
+template <typename Compare, typename Key>
+struct IsAscending : std::false_type {};
+template <typename Key>
+struct IsAscending<std::less<>, Key> : std::true_type {};
+template <typename Key>
+struct IsAscending<std::less<Key>, Key> : std::true_type {};
+
+template <typename Key, typename Compare>
+struct UseRadix
+    : std::integral_constant<bool, std::is_arithmetic<Key>::value && (sizeof(Key) == 4 || sizeof(Key) == 8) &&
+                                       IsAscending<Compare, Key>::value> {};
+
+// Pointers and vector iterators can be sorted in place; other random-access
+// iterators are sorted through a temporary vector
+template <typename It, typename T = typename std::iterator_traits<It>::value_type>
+struct IsContiguous
+    : std::integral_constant<bool, std::is_pointer<It>::value ||
+                                       std::is_same<It, typename std::vector<T>::iterator>::value> {};
+
+// Stable bottom-up merge sort of data[0, n): about four chunks per thread are
+// stable-sorted in parallel, then pairs of runs are merged level by level,
+// alternating between data and buffer. Each merge gets a share of the
+// threads proportional to its length, so the last levels (few, long runs)
+// are still split across all of them by merge path.
+template <typename T, typename Less>
+void mergeSortBottomUp(T* data, size_t n, T* buffer, Less less) {
+    const int threads = omp_get_max_threads();
+    const size_t chunks = std::max<size_t>(1, std::min<size_t>(4 * threads, n / 2048));
+    auto bound = [&](size_t c) { return n * std::min(c, chunks) / chunks; };
+
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int64_t c = 0; c < (int64_t)chunks; c++) std::stable_sort(data + bound(c), data + bound(c + 1), less);
+
+    T* src = data;
+    T* dst = buffer;
+    for (size_t width = 1; width < chunks; width *= 2) {
+        #pragma omp parallel
+        #pragma omp single
+        for (size_t c = 0; c < chunks; c += 2 * width) {
+            const size_t lo = bound(c), mid = bound(c + width), hi = bound(c + 2 * width);
+            const int slices = (int)std::max<size_t>(1, (threads * (hi - lo) + n - 1) / n);
+            #pragma omp task firstprivate(lo, mid, hi, slices)
+            parallelMerge(src + lo, (int64_t)(mid - lo), src + mid, (int64_t)(hi - mid), dst + lo, slices, less);
+        }
+        std::swap(src, dst);
+    }
+    if (src != data) {
+        #pragma omp parallel for schedule(static)
+        for (int64_t i = 0; i < (int64_t)n; i++) data[i] = src[i];
+    }
+}
+
+// mergeSortBottomUp over parallel arrays: values[i] moves with keys[i]
+// through keyBuffer and valueBuffer. std::stable_sort cannot carry a second
+// array, so each chunk is sorted by insertion sort of short runs followed by
+// a serial bottom-up merge, both moving keys and values together.
+template <typename K, typename V, typename Less>
+void mergeSortByKeyBottomUp(K* keys, V* values, size_t n, K* keyBuffer, V* valueBuffer, Less less) {
+    constexpr size_t run = 32;
+    const int threads = omp_get_max_threads();
+    const size_t chunks = std::max<size_t>(1, std::min<size_t>(4 * threads, n / 2048));
+    auto bound = [&](size_t c) { return n * std::min(c, chunks) / chunks; };
+
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int64_t c = 0; c < (int64_t)chunks; c++) {
+        const size_t lo = bound(c), hi = bound(c + 1);
+        for (size_t r = lo; r < hi; r += run) {
+            const size_t end = std::min(r + run, hi);
+            for (size_t i = r + 1; i < end; i++) {
+                K k = std::move(keys[i]);
+                V v = std::move(values[i]);
+                size_t j = i;
+                for (; j > r && less(k, keys[j - 1]); j--) {
+                    keys[j] = std::move(keys[j - 1]);
+                    values[j] = std::move(values[j - 1]);
+                }
+                keys[j] = std::move(k);
+                values[j] = std::move(v);
+            }
+        }
+        K* ks = keys;
+        V* vs = values;
+        K* kd = keyBuffer;
+        V* vd = valueBuffer;
+        for (size_t width = run; width < hi - lo; width *= 2) {
+            for (size_t a = lo; a < hi; a += 2 * width) {
+                const size_t mid = std::min(a + width, hi), end = std::min(a + 2 * width, hi);
+                mergeRunsByKey(ks + a, vs + a, (int64_t)(mid - a), ks + mid, vs + mid, (int64_t)(end - mid), kd + a,
+                               vd + a, less);
+            }
+            std::swap(ks, kd);
+            std::swap(vs, vd);
+        }
+        if (ks != keys) {
+            std::copy(ks + lo, ks + hi, keys + lo);
+            std::copy(vs + lo, vs + hi, values + lo);
+        }
+    }
+
+    K* ksrc = keys;
+    V* vsrc = values;
+    K* kdst = keyBuffer;
+    V* vdst = valueBuffer;
+    for (size_t width = 1; width < chunks; width *= 2) {
+        #pragma omp parallel
+        #pragma omp single
+        for (size_t c = 0; c < chunks; c += 2 * width) {
+            const size_t lo = bound(c), mid = bound(c + width), hi = bound(c + 2 * width);
+            const int slices = (int)std::max<size_t>(1, (threads * (hi - lo) + n - 1) / n);
+            #pragma omp task firstprivate(lo, mid, hi, slices)
+            parallelMergeByKey(ksrc + lo, vsrc + lo, (int64_t)(mid - lo), ksrc + mid, vsrc + mid, (int64_t)(hi - mid),
+                               kdst + lo, vdst + lo, slices, less);
+        }
+        std::swap(ksrc, kdst);
+        std::swap(vsrc, vdst);
+    }
+    if (ksrc != keys) {
+        #pragma omp parallel for schedule(static)
+        for (int64_t i = 0; i < (int64_t)n; i++) {
+            keys[i] = ksrc[i];
+            values[i] = vsrc[i];
+        }
+    }
+}
+
+template <typename T, typename Compare, typename Projection>
+void sortContiguous(T* data, size_t n, Compare, Projection proj, std::true_type /*radix*/) {
+    std::vector<T> buffer(n);
+    radix_detail::radixSortCore(data, buffer.data(), (char*)nullptr, (char*)nullptr, n,
+                                [&](const T& x) { return proj(x); });
+}
+
+template <typename T, typename Compare, typename Projection>
+void sortContiguous(T* data, size_t n, Compare comp, Projection proj, std::false_type /*comparison*/) {
+    std::vector<T> buffer(n);
+    mergeSortBottomUp(data, n, buffer.data(), [&](const T& a, const T& b) { return comp(proj(a), proj(b)); });
+}
+
+// Runs f(pointer, n) on the range, copying it out and back if it is not contiguous
+template <typename It, typename F>
+void withContiguous(It first, It last, F f) {
+    using T = typename std::iterator_traits<It>::value_type;
+    const size_t n = std::distance(first, last);
+    if (n == 0) return;
+    if (IsContiguous<It>::value) {
+        f(&*first, n);
+    } else {
+        std::vector<T> copy(first, last);
+        f(copy.data(), n);
+        std::copy(copy.begin(), copy.end(), first);
+    }
+}
+
+} // namespace parallel_sort_detail
+
+// Sorts [first, last) by comp(proj(a), proj(b)); e.g. records by one field:
+//   parallelSort(v.begin(), v.end(), std::less<>(), [](const Rec& r) { return r.key; });
+template <typename RandomIt, typename Compare = std::less<>, typename Projection = IdentityProjection>
+void parallelSort(RandomIt first, RandomIt last, Compare comp = Compare(), Projection proj = Projection()) {
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+    using Key = typename std::decay<decltype(proj(std::declval<const T&>()))>::type;
+    parallel_sort_detail::withContiguous(first, last, [&](T* data, size_t n) {
+        parallel_sort_detail::sortContiguous(data, n, comp, proj, parallel_sort_detail::UseRadix<Key, Compare>());
+    });
+}
+
+namespace parallel_sort_detail {
+
+template <typename K, typename V, typename Compare>
+void sortByKey(K* keys, V* values, size_t n, Compare, std::true_type /*radix*/) {
+    std::vector<K> keyBuffer(n);
+    std::vector<V> valueBuffer(n);
+    radix_detail::radixSortCore(keys, keyBuffer.data(), values, valueBuffer.data(), n, [](const K& k) { return k; });
+}
+
+// Comparison path: keys and values are merge sorted in lockstep through their
+// own buffers, so the extra memory is one copy of each array, as on the
+// radix path
+template <typename K, typename V, typename Compare>
+void sortByKey(K* keys, V* values, size_t n, Compare comp, std::false_type /*comparison*/) {
+    std::vector<K> keyBuffer(n);
+    std::vector<V> valueBuffer(n);
+    mergeSortByKeyBottomUp(keys, values, n, keyBuffer.data(), valueBuffer.data(), comp);
+}
+
+} // namespace parallel_sort_detail
+
+// Sorts the parallel arrays keys[0, n) and values[0, n) by key, without
+// building (key, value) pairs: the radix path scatters both arrays in the
+// same pass, the comparison path merges them in lockstep
+template <typename KeyIt, typename ValueIt, typename Compare = std::less<>>
+void parallelSortByKey(KeyIt keysFirst, KeyIt keysLast, ValueIt valuesFirst, Compare comp = Compare()) {
+    using K = typename std::iterator_traits<KeyIt>::value_type;
+    using V = typename std::iterator_traits<ValueIt>::value_type;
+    const size_t n = std::distance(keysFirst, keysLast);
+    parallel_sort_detail::withContiguous(valuesFirst, valuesFirst + n, [&](V* values, size_t) {
+        parallel_sort_detail::withContiguous(keysFirst, keysLast, [&](K* keys, size_t) {
+            parallel_sort_detail::sortByKey(keys, values, n, comp, parallel_sort_detail::UseRadix<K, Compare>());
+        });
+    });
+}
@@ -0,0 +1,156 @@
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <omp.h>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <iomanip>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include "parallel_sort.h"
+
+using namespace std;
+
+// Record sorted by one of its fields through a projection
+struct Trade {
+    int64_t id;
+    double price;
+    int32_t quantity;
+};
+
+bool operator==(const Trade& a, const Trade& b) {
+    return a.id == b.id && a.price == b.price && a.quantity == b.quantity;
+}
+
+// Times parallelSort-style call `sortFn` against std::stable_sort-style call
+// `referenceFn` on copies of input, and prints one result line
+template <typename T, typename SortFn, typename ReferenceFn>
+void compare(const string& name, const string& path, const vector<T>& input, SortFn sortFn, ReferenceFn referenceFn) {
+    vector<T> mine = input, reference = input;
+    auto start = chrono::high_resolution_clock::now();
+    sortFn(mine);
+    auto end = chrono::high_resolution_clock::now();
+    double par_time = chrono::duration<double>(end - start).count();
+
+    start = chrono::high_resolution_clock::now();
+    referenceFn(reference);
+    end = chrono::high_resolution_clock::now();
+    double std_time = chrono::duration<double>(end - start).count();
+
+    cout << left << setw(30) << name << setw(12) << path << right << setw(12) << par_time << setw(12) << std_time
+         << setw(10) << std_time / par_time << "   " << (mine == reference ? "Pass" : "Fail") << "\n";
+}
+
+int main(int argc, char* argv[]) {
+    // --size <n> (default 10000000) --threads <t>
+    long long SIZE = 10000000;
+    int numThreads = omp_get_max_threads();
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 < argc && strcmp(argv[i], "--size") == 0) SIZE = atoll(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "--threads") == 0) numThreads = atoi(argv[++i]);
+        else {
+            cout << "Usage: " << argv[0] << " [--size n] [--threads t]\n";
+            return 1;
+        }
+    }
+    if (SIZE < 1 || numThreads < 1) {
+        cout << "Size and threads must be at least 1.\n";
+        return 1;
+    }
+    omp_set_num_threads(numThreads);
+
+    mt19937_64 rng(42);
+    vector<int64_t> keys64(SIZE);
+    vector<double> doubles(SIZE);
+    vector<int> ints(SIZE);
+    vector<Trade> trades(SIZE);
+    vector<int32_t> payload(SIZE);
+    for (long long i = 0; i < SIZE; i++) {
+        keys64[i] = (int64_t)rng();
+        doubles[i] = (double)(int64_t)(rng() % 2000001) / 1000.0 - 1000.0;
+        ints[i] = rand() % 100000;
+        trades[i] = {(int64_t)(rng() % 1000000), (double)(rng() % 100000) / 100.0, (int32_t)i};
+        payload[i] = (int32_t)i;
+    }
+
+    cout << fixed << setprecision(6);
+    cout << "Sorting " << SIZE << " elements with " << numThreads << " threads\n";
+    cout << left << setw(30) << "Input" << setw(12) << "Path" << right << setw(12) << "parallel(s)" << setw(12)
+         << "std(s)" << setw(10) << "speedup" << "   Check\n";
+
+    compare("int64 keys", "radix", keys64, [](vector<int64_t>& v) { parallelSort(v.begin(), v.end()); },
+            [](vector<int64_t>& v) { stable_sort(v.begin(), v.end()); });
+    compare("double keys (negative too)", "radix", doubles, [](vector<double>& v) { parallelSort(v.begin(), v.end()); },
+            [](vector<double>& v) { stable_sort(v.begin(), v.end()); });
+    compare("int keys, descending", "merge", ints,
+            [](vector<int>& v) { parallelSort(v.begin(), v.end(), greater<int>()); },
+            [](vector<int>& v) { stable_sort(v.begin(), v.end(), greater<int>()); });
+    compare("trades by id (projection)", "radix", trades,
+            [](vector<Trade>& v) { parallelSort(v.begin(), v.end(), less<>(), [](const Trade& t) { return t.id; }); },
+            [](vector<Trade>& v) {
+                stable_sort(v.begin(), v.end(), [](const Trade& a, const Trade& b) { return a.id < b.id; });
+            });
+    compare("trades by price, descending", "merge", trades,
+            [](vector<Trade>& v) {
+                parallelSort(v.begin(), v.end(), greater<>(), [](const Trade& t) { return t.price; });
+            },
+            [](vector<Trade>& v) {
+                stable_sort(v.begin(), v.end(), [](const Trade& a, const Trade& b) { return a.price > b.price; });
+            });
+
+    // -0.0 == +0.0, so a stable sort must keep signed zeros in input order
+    vector<Trade> zeros = trades;
+    for (long long i = 0; i < SIZE; i++) zeros[i].price = i % 4 == 3 ? trades[i].price - 500.0 : (i % 2 ? -0.0 : 0.0);
+    compare("trades by price, signed zeros", "radix", zeros,
+            [](vector<Trade>& v) { parallelSort(v.begin(), v.end(), less<>(), [](const Trade& t) { return t.price; }); },
+            [](vector<Trade>& v) {
+                stable_sort(v.begin(), v.end(), [](const Trade& a, const Trade& b) { return a.price < b.price; });
+            });
+
+    // Struct of arrays: keys and payload sorted together, compared with a sort of pairs
+    vector<pair<int64_t, int32_t>> zipped(SIZE);
+    for (long long i = 0; i < SIZE; i++) zipped[i] = {keys64[i] % 1000000, payload[i]};
+    auto soa = [](bool descending) {
+        return [descending](vector<pair<int64_t, int32_t>>& v) {
+            vector<int64_t> k(v.size());
+            vector<int32_t> p(v.size());
+            for (size_t i = 0; i < v.size(); i++) k[i] = v[i].first, p[i] = v[i].second;
+            if (descending) parallelSortByKey(k.begin(), k.end(), p.begin(), greater<int64_t>());
+            else parallelSortByKey(k.begin(), k.end(), p.begin());
+            for (size_t i = 0; i < v.size(); i++) v[i] = {k[i], p[i]};
+        };
+    };
+    compare("key/value arrays", "radix", zipped, soa(false), [](vector<pair<int64_t, int32_t>>& v) {
+        stable_sort(v.begin(), v.end(), [](const pair<int64_t, int32_t>& a, const pair<int64_t, int32_t>& b) {
+            return a.first < b.first;
+        });
+    });
+    compare("key/value arrays, descending", "merge", zipped, soa(true), [](vector<pair<int64_t, int32_t>>& v) {
+        stable_sort(v.begin(), v.end(), [](const pair<int64_t, int32_t>& a, const pair<int64_t, int32_t>& b) {
+            return a.first > b.first;
+        });
+    });
+
+    // Non-contiguous iterators are sorted through a temporary vector
+    deque<int> dq(ints.begin(), ints.begin() + min<long long>(SIZE, 100000));
+    parallelSort(dq.begin(), dq.end());
+    cout << "deque<int> sorted: " << (is_sorted(dq.begin(), dq.end()) ? "Yes" : "No") << "\n";
+
+    return 0;
+}
+
+/*$ ./parallel_sort_generic.exe --size 10000000 --threads 4
+Sorting 10000000 elements with 4 threads
+Input                         Path         parallel(s)      std(s)   speedup   Check
+int64 keys                    radix           0.182710    0.757200  4.144270   Pass
+double keys (negative too)    radix           0.174065    0.800255  4.597443   Pass
+int keys, descending          merge           0.625177    0.572118  0.915129   Pass
+trades by id (projection)     radix           0.235469    0.762379  3.237700   Pass
+trades by price, descending   merge           0.806980    0.808193  1.001502   Pass
+key/value arrays              radix           0.215621    0.729217  3.381934   Pass
+key/value arrays, descending  merge           0.937988    0.719472  0.767037   Pass
+deque<int> sorted: Yes
+*/
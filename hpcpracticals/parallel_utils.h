@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <omp.h>
+
+// Small lock-free helpers shared by the OpenMP graph engines.
+// They wrap the GCC/Clang __atomic builtins so plain vectors (parent arrays,
+// labels, bitmaps) can be updated concurrently without a critical section.
+
+template <typename T>
+inline T atomicLoad(const T& target) {
+    return __atomic_load_n(&target, __ATOMIC_RELAXED);
+}
+
+template <typename T>
+inline void atomicStore(T& target, T value) {
+    __atomic_store_n(&target, value, __ATOMIC_RELAXED);
+}
+
+// Returns true if target held `expected` and now holds `desired`
+template <typename T>
+inline bool compareAndSwap(T& target, T expected, T desired) {
+    return __atomic_compare_exchange_n(&target, &expected, desired, false,
+                                       __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+}
+
+// Lowers target to value if value is smaller; returns true if this call lowered it
+template <typename T>
+inline bool atomicMin(T& target, T value) {
+    T current = atomicLoad(target);
+    while (value < current) {
+        if (__atomic_compare_exchange_n(&target, &current, value, true, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// One bit per vertex; 64x smaller than a bool array, so frontier checks stay in cache
+class Bitmap {
+public:
+    Bitmap() = default;
+    explicit Bitmap(size_t bits) { resize(bits); }
+
+    void resize(size_t bits) {
+        numBits = bits;
+        words.assign((bits + 63) / 64, 0);
+    }
+
+    void clear() {
+        #pragma omp parallel for schedule(static)
+        for (long long i = 0; i < (long long)words.size(); i++) words[i] = 0;
+    }
+
+    size_t size() const { return numBits; }
+
+    bool test(size_t i) const {
+        return (atomicLoad(words[i >> 6]) >> (i & 63)) & 1;
+    }
+
+    void set(size_t i) { words[i >> 6] |= uint64_t(1) << (i & 63); }
+
+    void setAtomic(size_t i) {
+        __atomic_fetch_or(&words[i >> 6], uint64_t(1) << (i & 63), __ATOMIC_RELAXED);
+    }
+
+    // Atomically sets bit i and returns its previous value; exactly one caller sees false
+    bool testAndSet(size_t i) {
+        uint64_t mask = uint64_t(1) << (i & 63);
+        return (__atomic_fetch_or(&words[i >> 6], mask, __ATOMIC_ACQ_REL) & mask) != 0;
+    }
+
+private:
+    size_t numBits = 0;
+    std::vector<uint64_t> words;
+};
+
+// In-place exclusive prefix sum over data[0, n); returns the total.
+// Each thread sums one contiguous block, the block totals are scanned
+// serially (one value per thread), then each thread rewrites its block.
+template <typename T>
+T parallelExclusiveScan(T* data, size_t n) {
+    const int maxThreads = omp_get_max_threads();
+    std::vector<T> blockSums(maxThreads + 1, 0);
+    T total = 0;
+
+    #pragma omp parallel
+    {
+        const int tid = omp_get_thread_num();
+        const int nt = omp_get_num_threads();
+        const size_t lo = n * tid / nt, hi = n * (tid + 1) / nt;
+
+        T sum = 0;
+        for (size_t i = lo; i < hi; i++) sum += data[i];
+        blockSums[tid + 1] = sum;
+
+        #pragma omp barrier
+        #pragma omp single
+        {
+            for (int t = 0; t < nt; t++) blockSums[t + 1] += blockSums[t];
+            total = blockSums[nt];
+        }
+
+        T running = blockSums[tid];
+        for (size_t i = lo; i < hi; i++) {
+            T x = data[i];
+            data[i] = running;
+            running += x;
+        }
+    }
+    return total;
+}
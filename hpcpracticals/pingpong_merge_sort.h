@@ -0,0 +1,163 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <omp.h>
+#include "parallel_merge.h"
+
+// Merge sort that never copies back: each recursion level merges from one
+// buffer into the other, and all scratch comes from a reusable arena, so a
+// warm sort does no heap allocation at all.
+
+// Memory traffic of one sort
+struct SortTraffic {
+    size_t allocations = 0;    // Arena growths (heap allocations) during the sort
+    size_t bytesAllocated = 0; // Bytes those growths allocated
+    size_t bytesMoved = 0;     // Bytes written by merges and leaf copies
+    int levels = 0;            // Merge levels above the leaves
+};
+
+// Scratch for pingPongMergeSort: one partner buffer as large as the biggest
+// array sorted so far, plus a per-thread byte counter on its own cache line
+// (threads bump their own slot, so counting adds no sharing). Keep one arena
+// per repeatedly sorted array size and reuse it; only growth allocates.
+template <typename T>
+class MergeSortArena {
+public:
+    MergeSortArena() = default;
+    explicit MergeSortArena(size_t n) { reserve(n); }
+
+    // Buffer for n elements; reallocates only if n exceeds the capacity
+    T* reserve(size_t n) {
+        if (n > capacity) {
+            block.reset(new T[n]);
+            capacity = n;
+            allocations++;
+            bytesAllocated += n * sizeof(T);
+        }
+        const size_t threads = omp_get_max_threads();
+        if (moved.size() < threads) {
+            moved.resize(threads);
+            allocations++;
+            bytesAllocated += threads * sizeof(Slot);
+        }
+        return block.get();
+    }
+
+    // Called from inside a parallel region by the thread that wrote the bytes
+    void addMoved(size_t bytes) { moved[omp_get_thread_num()].bytes += bytes; }
+
+    // Returns the traffic since the last call and starts a new count
+    SortTraffic takeTraffic() {
+        SortTraffic t;
+        t.allocations = allocations;
+        t.bytesAllocated = bytesAllocated;
+        for (Slot& s : moved) {
+            t.bytesMoved += s.bytes;
+            s.bytes = 0;
+        }
+        allocations = bytesAllocated = 0;
+        return t;
+    }
+
+    size_t size() const { return capacity; }
+
+private:
+    struct alignas(64) Slot {
+        size_t bytes = 0;
+    };
+
+    std::unique_ptr<T[]> block;
+    size_t capacity = 0;
+    std::vector<Slot> moved;
+    size_t allocations = 0, bytesAllocated = 0;
+};
+
+namespace pingpong_detail {
+
+// Stable insertion sort for the leaves
+template <typename T, typename Less>
+void insertionSort(T* data, size_t n, Less less) {
+    for (size_t i = 1; i < n; i++) {
+        T x = data[i];
+        size_t j = i;
+        while (j > 0 && less(x, data[j - 1])) {
+            data[j] = data[j - 1];
+            j--;
+        }
+        data[j] = x;
+    }
+}
+
+// Sorts the n elements at src and leaves the result in dst when toDst is
+// set, in src otherwise; the other buffer is scratch. Both halves are sorted
+// into the buffer the merge reads from, so no level copies anything back.
+template <typename T, typename Less, typename LeafSort>
+void sortInto(T* src, T* dst, size_t n, bool toDst, int depth, int maxDepth, size_t leafSize, Less less,
+              LeafSort leafSort, MergeSortArena<T>& arena) {
+    if (n <= leafSize) {
+        T* out = src;
+        if (toDst) {
+            std::copy(src, src + n, dst);
+            arena.addMoved(n * sizeof(T));
+            out = dst;
+        }
+        leafSort(out, n);
+        return;
+    }
+
+    const size_t half = n / 2;
+    if (depth < maxDepth) {
+        #pragma omp task shared(arena) firstprivate(less, leafSort)
+        sortInto(src, dst, half, !toDst, depth + 1, maxDepth, leafSize, less, leafSort, arena);
+        #pragma omp task shared(arena) firstprivate(less, leafSort)
+        sortInto(src + half, dst + half, n - half, !toDst, depth + 1, maxDepth, leafSize, less, leafSort, arena);
+        #pragma omp taskwait
+    } else {
+        sortInto(src, dst, half, !toDst, depth + 1, maxDepth, leafSize, less, leafSort, arena);
+        sortInto(src + half, dst + half, n - half, !toDst, depth + 1, maxDepth, leafSize, less, leafSort, arena);
+    }
+
+    // The halves now sit in the buffer this level does not write
+    const T* from = toDst ? src : dst;
+    T* to = toDst ? dst : src;
+    const int slices = (int)std::min<size_t>(omp_get_num_threads(), n / 8192);
+    parallelMerge(from, (int64_t)half, from + half, (int64_t)(n - half), to, slices, less);
+    arena.addMoved(n * sizeof(T));
+}
+
+} // namespace pingpong_detail
+
+// Stable merge sort of data[0, n) with scratch from arena. Subarrays of up
+// to leafSize elements are sorted in place by leafSort(pointer, count); the
+// levels above alternate direction (data -> scratch -> data ...), so every
+// element is written once per level instead of twice, and the result lands
+// in data without a final copy. Tasks split the recursion down to about four
+// leaf tasks per thread, and large merges are split by merge path.
+template <typename T, typename Less, typename LeafSort>
+SortTraffic pingPongMergeSort(T* data, size_t n, MergeSortArena<T>& arena, Less less, LeafSort leafSort,
+                              size_t leafSize) {
+    T* scratch = arena.reserve(n);
+    const int threads = omp_get_max_threads();
+    int maxDepth = 0;
+    while (threads > 1 && (1 << maxDepth) < 4 * threads) maxDepth++;
+
+    #pragma omp parallel
+    #pragma omp single
+    pingpong_detail::sortInto(data, scratch, n, false, 0, maxDepth, std::max<size_t>(leafSize, 1), less, leafSort,
+                              arena);
+
+    SortTraffic traffic = arena.takeTraffic();
+    for (size_t len = n; len > leafSize; len = (len + 1) / 2) traffic.levels++;
+    return traffic;
+}
+
+template <typename T, typename Less = std::less<T>>
+SortTraffic pingPongMergeSort(T* data, size_t n, MergeSortArena<T>& arena, Less less = Less()) {
+    return pingPongMergeSort(data, n, arena, less,
+                             [less](T* leaf, size_t count) { pingpong_detail::insertionSort(leaf, count, less); }, 32);
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+#include <omp.h>
+
+// Parallel LSD radix sort for 32- and 64-bit keys, one byte per pass.
+
+namespace radix_detail {
+
+template <typename K>
+struct KeyBits {
+    using type = typename std::conditional<sizeof(K) == 4, uint32_t, uint64_t>::type;
+};
+
+// Maps a key to an unsigned value with the same order. Signed integers flip
+// the sign bit, which puts negative keys below the non-negative ones;
+// floating-point keys flip every bit when negative (larger magnitude sorts
+// lower) and only the sign bit otherwise. -0.0 is mapped to +0.0 first, since
+// the two compare equal and a stable sort must keep them in input order; NaN
+// keys, which operator< does not order, all map to the largest value and so
+// sort last, after +inf, in input order.
+template <typename K>
+inline typename KeyBits<K>::type sortableBits(K key) {
+    static_assert(std::is_arithmetic<K>::value && (sizeof(K) == 4 || sizeof(K) == 8),
+                  "radix sort keys are 32- or 64-bit integers or floating-point numbers");
+    using U = typename KeyBits<K>::type;
+    const U sign = (U)1 << (sizeof(K) * 8 - 1);
+    if (std::is_floating_point<K>::value) {
+        if (key != key) return ~(U)0;
+        if (key == 0) key = 0;
+    }
+    U bits;
+    std::memcpy(&bits, &key, sizeof(K));
+    if (std::is_floating_point<K>::value) return (bits & sign) ? ~bits : bits | sign;
+    if (std::is_signed<K>::value) return bits ^ sign;
+    return bits;
+}
+
+// Sorts data[0, n) by key(element) through buffer; when values is non-null,
+// values[i] travels with data[i] through valueBuffer (struct-of-arrays
+// sorting). Returns the number of scatter passes.
+template <typename T, typename KeyFn, typename V>
+int radixSortCore(T* data, T* buffer, V* values, V* valueBuffer, size_t n, KeyFn key) {
+    using K = typename std::decay<decltype(key(data[0]))>::type;
+    const int bytes = sizeof(K);
+    const int maxThreads = omp_get_max_threads();
+    if (n < 2) return 0;
+
+    // 1. All byte histograms in one pass
+    std::vector<size_t> total(bytes * 256, 0);
+    #pragma omp parallel
+    {
+        std::vector<size_t> local(bytes * 256, 0);
+        #pragma omp for schedule(static) nowait
+        for (size_t i = 0; i < n; i++) {
+            auto bits = sortableBits(key(data[i]));
+            for (int b = 0; b < bytes; b++) local[b * 256 + ((bits >> (8 * b)) & 0xff)]++;
+        }
+        #pragma omp critical
+        for (int i = 0; i < bytes * 256; i++) total[i] += local[i];
+    }
+    std::vector<int> passes;
+    for (int b = 0; b < bytes; b++) {
+        if (std::count(total.begin() + b * 256, total.begin() + (b + 1) * 256, n) == 0) passes.push_back(b);
+    }
+    if (passes.empty()) return 0;
+
+    // 2. Counting scatter for every byte that varies
+    std::vector<size_t> counts((size_t)maxThreads * 256);
+    T* src = data;
+    T* dst = buffer;
+    V* vsrc = values;
+    V* vdst = valueBuffer;
+    #pragma omp parallel
+    {
+        const int tid = omp_get_thread_num();
+        const int nt = omp_get_num_threads();
+        const size_t lo = n * tid / nt, hi = n * (tid + 1) / nt;
+        size_t* mine = counts.data() + (size_t)tid * 256;
+
+        for (int b : passes) {
+            const int shift = 8 * b;
+            std::fill(mine, mine + 256, 0);
+            for (size_t i = lo; i < hi; i++) mine[(sortableBits(key(src[i])) >> shift) & 0xff]++;
+            #pragma omp barrier
+            #pragma omp single
+            {
+                size_t running = 0;
+                for (int d = 0; d < 256; d++) {
+                    for (int t = 0; t < nt; t++) {
+                        size_t c = counts[(size_t)t * 256 + d];
+                        counts[(size_t)t * 256 + d] = running;
+                        running += c;
+                    }
+                }
+            }
+            for (size_t i = lo; i < hi; i++) {
+                size_t pos = mine[(sortableBits(key(src[i])) >> shift) & 0xff]++;
+                dst[pos] = src[i];
+                if (values) vdst[pos] = vsrc[i];
+            }
+            #pragma omp barrier
+            #pragma omp single
+            {
+                std::swap(src, dst);
+                std::swap(vsrc, vdst);
+            }
+        }
+        if (src != data) {
+            std::copy(src + lo, src + hi, data + lo);
+            if (values) std::copy(vsrc + lo, vsrc + hi, values + lo);
+        }
+    }
+    return (int)passes.size();
+}
+
+} // namespace radix_detail
+
+// Sorts data[0, n) using buffer[0, n) as scratch and returns the number of
+// scatter passes it ran (at most sizeof(T)). Stable.
+//  1. One read pass builds per-thread histograms of every byte at once; a
+//     byte whose histogram has a single non-zero bucket is the same in every
+//     key, so its pass is skipped (keys in [0, 100000) need 3 of 4 passes,
+//     since their top byte never changes).
+//  2. Each remaining pass: every thread counts the digit in its static block,
+//     the counts are prefix-summed digit-major, thread-minor, so each thread
+//     owns a disjoint, stable output range per digit, then every thread
+//     scatters its block. Source and destination swap each pass; an odd
+//     pass count ends with one parallel copy back into data.
+// All passes run in one parallel region, separated by barriers.
+template <typename T>
+int radixSortParallel(T* data, size_t n, T* buffer) {
+    return radix_detail::radixSortCore(data, buffer, (char*)nullptr, (char*)nullptr, n, [](const T& x) { return x; });
+}
+
+template <typename T>
+int radixSortParallel(std::vector<T>& data) {
+    std::vector<T> buffer(data.size());
+    return radixSortParallel(data.data(), data.size(), buffer.data());
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <omp.h>
+
+// Parallel samplesort: one classification pass into many buckets, then
+// independent per-bucket sorts. Not stable.
+
+namespace sample_sort_detail {
+
+inline uint64_t mix(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+} // namespace sample_sort_detail
+
+// Sorts data[0, n) with buffer[0, n) as scratch.
+//  1. Splitters: oversample * buckets random keys are sorted and every
+//     oversample-th one is kept, so each bucket's expected share is within a
+//     few percent of n / buckets. Repeated splitters are merged.
+//  2. Classification: bucket 2i holds keys strictly between splitters i - 1
+//     and i, bucket 2i + 1 holds keys equal to splitter i. A value common
+//     enough to be sampled twice therefore lands in its own equality bucket,
+//     which needs no sorting, and heavy duplicates cannot overload a bucket.
+//     Each thread finds the bucket of every key in its block once (binary
+//     search), keeping the ids for the scatter.
+//  3. Per-thread counts are prefix-summed bucket-major, the keys scattered
+//     into buffer, and each bucket sorted and copied back by whichever
+//     thread picks it up (dynamic schedule, about four buckets per thread).
+// Inputs below `cutoff` elements, or runs on one thread, go to std::sort.
+template <typename T, typename Less>
+void sampleSortParallel(T* data, size_t n, T* buffer, Less less, size_t cutoff = 1 << 16) {
+    const int threads = omp_get_max_threads();
+    if (n < cutoff || threads == 1) {
+        std::sort(data, data + n, less);
+        return;
+    }
+
+    // 1. Splitters from an oversampled random sample
+    const int targetBuckets = 4 * threads, oversample = 32;
+    std::vector<T> sample((size_t)targetBuckets * oversample);
+    for (size_t i = 0; i < sample.size(); i++) sample[i] = data[sample_sort_detail::mix(i) % n];
+    std::sort(sample.begin(), sample.end(), less);
+    std::vector<T> splitters;
+    for (int b = 1; b < targetBuckets; b++) {
+        const T& s = sample[(size_t)b * oversample];
+        if (splitters.empty() || less(splitters.back(), s)) splitters.push_back(s);
+    }
+    const int numSplitters = (int)splitters.size();
+    const int numBuckets = 2 * numSplitters + 1;
+
+    // 2. Classification with the bucket ids kept for the scatter
+    std::vector<uint16_t> bucketOf(n);
+    std::vector<size_t> counts((size_t)threads * numBuckets, 0);
+    std::vector<size_t> bucketStart(numBuckets + 1, 0);
+    #pragma omp parallel
+    {
+        const int tid = omp_get_thread_num();
+        const int nt = omp_get_num_threads();
+        const size_t lo = n * tid / nt, hi = n * (tid + 1) / nt;
+        size_t* mine = counts.data() + (size_t)tid * numBuckets;
+
+        for (size_t i = lo; i < hi; i++) {
+            const T& key = data[i];
+            int j = (int)(std::lower_bound(splitters.begin(), splitters.end(), key, less) - splitters.begin());
+            int b = (j < numSplitters && !less(key, splitters[j])) ? 2 * j + 1 : 2 * j;
+            bucketOf[i] = (uint16_t)b;
+            mine[b]++;
+        }
+        #pragma omp barrier
+        #pragma omp single
+        {
+            size_t running = 0;
+            for (int b = 0; b < numBuckets; b++) {
+                bucketStart[b] = running;
+                for (int t = 0; t < nt; t++) {
+                    size_t c = counts[(size_t)t * numBuckets + b];
+                    counts[(size_t)t * numBuckets + b] = running;
+                    running += c;
+                }
+            }
+            bucketStart[numBuckets] = running;
+        }
+
+        // 3. Scatter, then sort each bucket and copy it home
+        for (size_t i = lo; i < hi; i++) buffer[mine[bucketOf[i]]++] = data[i];
+        #pragma omp barrier
+        #pragma omp for schedule(dynamic, 1)
+        for (int b = 0; b < numBuckets; b++) {
+            T* first = buffer + bucketStart[b];
+            T* last = buffer + bucketStart[b + 1];
+            if (b % 2 == 0) std::sort(first, last, less);
+            std::copy(first, last, data + bucketStart[b]);
+        }
+    }
+}
+
+template <typename T>
+void sampleSortParallel(std::vector<T>& data) {
+    std::vector<T> buffer(data.size());
+    sampleSortParallel(data.data(), data.size(), buffer.data(), [](const T& a, const T& b) { return a < b; });
+}
@@ -0,0 +1,264 @@
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_SORT_X86 1
+#include <immintrin.h>
+#else
+#define SIMD_SORT_X86 0
+#endif
+
+// Vectorized base case for the merge sorts: sorts up to kSimdLeaf ints with
+// in-register bitonic networks and bitonic merges of small runs. The AVX2 and
+// AVX-512 kernels are compiled with target attributes, so no -mavx flags are
+// needed, and the widest one the CPU supports is picked at run time.
+
+enum class SimdLevel { Scalar, AVX2, AVX512 };
+
+inline const char* simdLevelName(SimdLevel level) {
+    return level == SimdLevel::AVX512 ? "AVX-512" : level == SimdLevel::AVX2 ? "AVX2" : "scalar";
+}
+
+// Widest supported level, capped by SIMD_SORT=scalar|avx2 for comparisons
+inline SimdLevel detectSimdLevel() {
+    static const SimdLevel level = [] {
+        SimdLevel best = SimdLevel::Scalar;
+#if SIMD_SORT_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) best = SimdLevel::AVX2;
+        if (__builtin_cpu_supports("avx512f")) best = SimdLevel::AVX512;
+#endif
+        const char* cap = std::getenv("SIMD_SORT");
+        if (cap && std::strcmp(cap, "scalar") == 0) best = SimdLevel::Scalar;
+        if (cap && std::strcmp(cap, "avx2") == 0 && best == SimdLevel::AVX512) best = SimdLevel::AVX2;
+        return best;
+    }();
+    return level;
+}
+
+const int kSimdLeaf = 256; // Largest array the base case sorts
+
+#if SIMD_SORT_X86
+namespace simd_sort_detail {
+
+#define SIMD_SORT_AVX2 __attribute__((target("avx2")))
+#define SIMD_SORT_AVX512 __attribute__((target("avx512f")))
+
+// Lane i of a bitonic compare-exchange at distance J inside blocks of K keeps
+// the maximum of (i, i ^ J) when it is the upper lane of an ascending block
+// or the lower lane of a descending one
+constexpr unsigned maxLanes(int lanes, int j, int k) {
+    unsigned mask = 0;
+    for (int i = 0; i < lanes; i++) {
+        if ((i > (i ^ j)) != ((i & k) != 0)) mask |= 1u << i;
+    }
+    return mask;
+}
+
+// ---- AVX2: 8 ints per register ----
+
+template <int J, int K>
+SIMD_SORT_AVX2 inline __m256i exchange8(__m256i v) {
+    const __m256i idx = _mm256_xor_si256(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(J));
+    __m256i p = _mm256_permutevar8x32_epi32(v, idx);
+    return _mm256_blend_epi32(_mm256_min_epi32(v, p), _mm256_max_epi32(v, p), maxLanes(8, J, K));
+}
+
+SIMD_SORT_AVX2 inline __m256i sort8(__m256i v) {
+    v = exchange8<1, 2>(v);
+    v = exchange8<2, 4>(v);
+    v = exchange8<1, 4>(v);
+    v = exchange8<4, 8>(v);
+    v = exchange8<2, 8>(v);
+    return exchange8<1, 8>(v);
+}
+
+// Sorts a bitonic register
+SIMD_SORT_AVX2 inline __m256i finish8(__m256i v) {
+    v = exchange8<4, 8>(v);
+    v = exchange8<2, 8>(v);
+    return exchange8<1, 8>(v);
+}
+
+SIMD_SORT_AVX2 inline __m256i reverse8(__m256i v) {
+    return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+}
+
+// Two sorted registers -> the 8 smallest (lo) and 8 largest (hi), both sorted
+SIMD_SORT_AVX2 inline void merge8(__m256i a, __m256i b, __m256i& lo, __m256i& hi) {
+    b = reverse8(b);
+    lo = finish8(_mm256_min_epi32(a, b));
+    hi = finish8(_mm256_max_epi32(a, b));
+}
+
+// 32 keys: four 8-key networks, two 16-key merges, one 32-key merge
+SIMD_SORT_AVX2 inline void sort32(int* p) {
+    __m256i v0 = sort8(_mm256_loadu_si256((const __m256i*)p));
+    __m256i v1 = sort8(_mm256_loadu_si256((const __m256i*)(p + 8)));
+    __m256i v2 = sort8(_mm256_loadu_si256((const __m256i*)(p + 16)));
+    __m256i v3 = sort8(_mm256_loadu_si256((const __m256i*)(p + 24)));
+    __m256i a0, a1, b0, b1;
+    merge8(v0, v1, a0, a1);
+    merge8(v2, v3, b0, b1);
+    // Against the reversed second run, the minima form a bitonic 16-key
+    // sequence holding the smallest half, the maxima one holding the rest
+    __m256i rb0 = reverse8(b1), rb1 = reverse8(b0);
+    __m256i l0 = _mm256_min_epi32(a0, rb0), l1 = _mm256_min_epi32(a1, rb1);
+    __m256i h0 = _mm256_max_epi32(a0, rb0), h1 = _mm256_max_epi32(a1, rb1);
+    _mm256_storeu_si256((__m256i*)p, finish8(_mm256_min_epi32(l0, l1)));
+    _mm256_storeu_si256((__m256i*)(p + 8), finish8(_mm256_max_epi32(l0, l1)));
+    _mm256_storeu_si256((__m256i*)(p + 16), finish8(_mm256_min_epi32(h0, h1)));
+    _mm256_storeu_si256((__m256i*)(p + 24), finish8(_mm256_max_epi32(h0, h1)));
+}
+
+// Merges sorted runs whose lengths are multiples of 8: every step merges the
+// carried 8 largest keys with the next block of whichever run has the
+// smaller head, and emits the lower 8
+SIMD_SORT_AVX2 inline void mergeRuns8(const int* a, int na, const int* b, int nb, int* out) {
+    __m256i va = _mm256_loadu_si256((const __m256i*)a), vb = _mm256_loadu_si256((const __m256i*)b);
+    int ia = 8, ib = 8;
+    for (;;) {
+        __m256i lo, hi;
+        merge8(va, vb, lo, hi);
+        _mm256_storeu_si256((__m256i*)out, lo);
+        out += 8;
+        if (ia < na && (ib >= nb || a[ia] <= b[ib])) {
+            va = _mm256_loadu_si256((const __m256i*)(a + ia));
+            ia += 8;
+        } else if (ib < nb) {
+            va = _mm256_loadu_si256((const __m256i*)(b + ib));
+            ib += 8;
+        } else {
+            _mm256_storeu_si256((__m256i*)out, hi);
+            return;
+        }
+        vb = hi;
+    }
+}
+
+// ---- AVX-512: 16 ints per register ----
+// Full-mask forms of min/max/permute: the plain intrinsics read an undefined
+// source register, which GCC 12 reports as uninitialized under -Wall
+
+SIMD_SORT_AVX512 inline __m512i min16(__m512i a, __m512i b) { return _mm512_mask_min_epi32(a, 0xFFFF, a, b); }
+SIMD_SORT_AVX512 inline __m512i max16(__m512i a, __m512i b) { return _mm512_mask_max_epi32(a, 0xFFFF, a, b); }
+SIMD_SORT_AVX512 inline __m512i permute16(__m512i idx, __m512i v) {
+    return _mm512_mask_permutexvar_epi32(v, 0xFFFF, idx, v);
+}
+
+template <int J, int K>
+SIMD_SORT_AVX512 inline __m512i exchange16(__m512i v) {
+    const __m512i idx = _mm512_xor_si512(
+        _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), _mm512_set1_epi32(J));
+    __m512i p = permute16(idx, v);
+    return _mm512_mask_max_epi32(min16(v, p), (__mmask16)maxLanes(16, J, K), v, p);
+}
+
+SIMD_SORT_AVX512 inline __m512i sort16(__m512i v) {
+    v = exchange16<1, 2>(v);
+    v = exchange16<2, 4>(v);
+    v = exchange16<1, 4>(v);
+    v = exchange16<4, 8>(v);
+    v = exchange16<2, 8>(v);
+    v = exchange16<1, 8>(v);
+    v = exchange16<8, 16>(v);
+    v = exchange16<4, 16>(v);
+    v = exchange16<2, 16>(v);
+    return exchange16<1, 16>(v);
+}
+
+SIMD_SORT_AVX512 inline __m512i finish16(__m512i v) {
+    v = exchange16<8, 16>(v);
+    v = exchange16<4, 16>(v);
+    v = exchange16<2, 16>(v);
+    return exchange16<1, 16>(v);
+}
+
+SIMD_SORT_AVX512 inline void merge16(__m512i a, __m512i b, __m512i& lo, __m512i& hi) {
+    b = permute16(_mm512_setr_epi32(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0), b);
+    lo = finish16(min16(a, b));
+    hi = finish16(max16(a, b));
+}
+
+// 32 keys: two 16-key networks and one 32-key merge
+SIMD_SORT_AVX512 inline void sort32x512(int* p) {
+    __m512i lo, hi;
+    merge16(sort16(_mm512_loadu_si512(p)), sort16(_mm512_loadu_si512(p + 16)), lo, hi);
+    _mm512_storeu_si512(p, lo);
+    _mm512_storeu_si512(p + 16, hi);
+}
+
+SIMD_SORT_AVX512 inline void mergeRuns16(const int* a, int na, const int* b, int nb, int* out) {
+    __m512i va = _mm512_loadu_si512(a), vb = _mm512_loadu_si512(b);
+    int ia = 16, ib = 16;
+    for (;;) {
+        __m512i lo, hi;
+        merge16(va, vb, lo, hi);
+        _mm512_storeu_si512(out, lo);
+        out += 16;
+        if (ia < na && (ib >= nb || a[ia] <= b[ib])) {
+            va = _mm512_loadu_si512(a + ia);
+            ia += 16;
+        } else if (ib < nb) {
+            va = _mm512_loadu_si512(b + ib);
+            ib += 16;
+        } else {
+            _mm512_storeu_si512(out, hi);
+            return;
+        }
+        vb = hi;
+    }
+}
+
+// Sorts buf[0, padded) (padded is a multiple of 32) through tmp; returns
+// whichever of the two holds the result
+template <bool Wide>
+inline int* sortPadded(int* buf, int* tmp, int padded) {
+    for (int i = 0; i < padded; i += 32) {
+        if (Wide) sort32x512(buf + i);
+        else sort32(buf + i);
+    }
+    int* src = buf;
+    int* dst = tmp;
+    for (int width = 32; width < padded; width *= 2) {
+        for (int i = 0; i < padded; i += 2 * width) {
+            if (i + width >= padded) {
+                std::memcpy(dst + i, src + i, (padded - i) * sizeof(int));
+            } else if (Wide) {
+                mergeRuns16(src + i, width, src + i + width, std::min(width, padded - i - width), dst + i);
+            } else {
+                mergeRuns8(src + i, width, src + i + width, std::min(width, padded - i - width), dst + i);
+            }
+        }
+        std::swap(src, dst);
+    }
+    return src;
+}
+
+} // namespace simd_sort_detail
+#endif
+
+// Sorts data[0, n) for n <= kSimdLeaf. The keys are copied into a stack
+// buffer padded with INT_MAX up to a multiple of 32, so every network and
+// merge works on whole registers; the first n results are copied back.
+inline void simdSortSmall(int* data, int n, SimdLevel level = detectSimdLevel()) {
+#if SIMD_SORT_X86
+    if (level != SimdLevel::Scalar && n > 1 && n <= kSimdLeaf) {
+        alignas(64) int buf[kSimdLeaf];
+        alignas(64) int tmp[kSimdLeaf];
+        const int padded = (n + 31) & ~31;
+        std::memcpy(buf, data, n * sizeof(int));
+        std::fill(buf + n, buf + padded, INT_MAX);
+        int* sorted = level == SimdLevel::AVX512 ? simd_sort_detail::sortPadded<true>(buf, tmp, padded)
+                                                 : simd_sort_detail::sortPadded<false>(buf, tmp, padded);
+        std::memcpy(data, sorted, n * sizeof(int));
+        return;
+    }
+#endif
+    (void)level;
+    std::sort(data, data + n);
+}
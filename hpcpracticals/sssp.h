@@ -0,0 +1,256 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+#include <omp.h>
+#include "weighted_graph.h"
+#include "parallel_utils.h"
+
+// Single-source shortest paths on WeightedCSRGraph: a sequential Dijkstra
+// reference and a parallel delta-stepping engine.
+
+struct SSSPResult {
+    static constexpr int64_t unreachable = std::numeric_limits<int64_t>::max();
+    std::vector<int64_t> distance; // unreachable if the source cannot reach the vertex
+    int64_t reached = 0;
+    int64_t buckets = 0;     // Buckets settled (one per distinct distance for Dijkstra)
+    int64_t phases = 0;      // Light-edge rounds over all buckets
+    int64_t relaxations = 0; // Arcs relaxed
+};
+
+// Dijkstra with a binary heap and lazy deletion
+template <typename Graph>
+SSSPResult dijkstraSSSP(const Graph& g, typename Graph::vertex_type source) {
+    using V = typename Graph::vertex_type;
+    SSSPResult result;
+    result.distance.assign(g.numVertices(), SSSPResult::unreachable);
+    result.distance[source] = 0;
+
+    using Entry = std::pair<int64_t, V>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+    heap.push({0, source});
+    while (!heap.empty()) {
+        Entry top = heap.top();
+        heap.pop();
+        V v = top.second;
+        if (top.first != result.distance[v]) continue; // Stale entry
+        result.reached++;
+        auto nbrs = g.neighbors(v);
+        const auto* w = g.weights(v);
+        for (size_t k = 0; k < nbrs.size(); k++) {
+            V u = nbrs.begin()[k];
+            int64_t nd = top.first + w[k];
+            result.relaxations++;
+            if (nd < result.distance[u]) {
+                result.distance[u] = nd;
+                heap.push({nd, u});
+            }
+        }
+    }
+    result.buckets = result.reached;
+    return result;
+}
+
+struct DeltaSteppingOptions {
+    int64_t delta = 0; // Bucket width; 0 picks suggestDelta(g)
+};
+
+// Meyer and Sanders' rule of thumb: a bucket should span about one edge of
+// average weight per neighbour, i.e. maxWeight / average degree
+template <typename Graph>
+int64_t suggestDelta(const Graph& g) {
+    double avgDegree = g.numVertices() > 0 ? (double)g.numArcs() / g.numVertices() : 1.0;
+    return std::max<int64_t>(1, (int64_t)(g.maxWeight() / std::max(avgDegree, 1.0)));
+}
+
+// Delta-stepping: vertices sit in buckets of width delta by tentative
+// distance, and the lowest non-empty bucket is settled in parallel.
+//  - Light arcs (weight <= delta) can land back in the current bucket, so
+//    its vertices are relaxed in rounds until no round refills it.
+//  - Heavy arcs can only reach later buckets; they are relaxed once per
+//    settled vertex after the bucket is final.
+// Distances are lowered with atomicMin and every successful lowering bins
+// the vertex into the calling thread's own buckets, so relaxing never
+// touches shared state. Each thread keeps a cyclic window of
+// maxWeight / delta + 2 buckets (every relaxation lands inside it), capped at
+// maxBucketWindow; anything beyond the cap waits in a per-thread far list
+// and is rebinned once the window reaches it. A bucket is gathered by a
+// prefix sum over the threads' bin sizes followed by a parallel copy.
+// Duplicate entries are harmless (a stale one relaxes nothing new).
+// delta = 1 on integer weights behaves like Dijkstra, a delta above the
+// largest weight like a parallel Bellman-Ford.
+template <typename Graph>
+SSSPResult deltaSteppingSSSP(const Graph& g, typename Graph::vertex_type source,
+                             const DeltaSteppingOptions& options = DeltaSteppingOptions()) {
+    using V = typename Graph::vertex_type;
+    constexpr int64_t maxBucketWindow = 4096;
+    constexpr int64_t none = std::numeric_limits<int64_t>::max();
+    const V n = g.numVertices();
+    const int64_t delta = options.delta > 0 ? options.delta : suggestDelta(g);
+    const int64_t window = std::min<int64_t>((int64_t)g.maxWeight() / delta + 2, maxBucketWindow);
+    SSSPResult result;
+    std::vector<int64_t>& distance = result.distance;
+    distance.assign(n, SSSPResult::unreachable);
+    distance[source] = 0;
+
+    const int maxThreads = omp_get_max_threads();
+    std::vector<std::vector<std::vector<V>>> bins(maxThreads, std::vector<std::vector<V>>(window));
+    std::vector<std::vector<std::pair<int64_t, V>>> far(maxThreads); // (bucket, vertex) past the window
+    std::vector<int64_t> farMin(maxThreads, none);
+    std::vector<std::vector<V>> settledBuffers(maxThreads);
+    std::vector<size_t> offsets(maxThreads + 1);
+    Bitmap settled(n);
+    std::vector<V> current, settledList;
+    bins[0][0].push_back(source);
+
+    // Concatenates part(t) over all threads into out and empties the parts
+    auto gather = [&](std::vector<V>& out, auto&& part) {
+        offsets[0] = 0;
+        for (int t = 0; t < maxThreads; t++) offsets[t + 1] = offsets[t] + part(t).size();
+        out.resize(offsets[maxThreads]);
+        #pragma omp parallel for schedule(static, 1)
+        for (int t = 0; t < maxThreads; t++) {
+            std::vector<V>& src = part(t);
+            std::copy(src.begin(), src.end(), out.begin() + offsets[t]);
+            src.clear();
+        }
+    };
+    auto binEmpty = [&](int64_t b) {
+        for (int t = 0; t < maxThreads; t++) {
+            if (!bins[t][b % window].empty()) return false;
+        }
+        return true;
+    };
+    // Lowest bucket at or after from: a window bin if one is non-empty, else
+    // the smallest far entry
+    auto nextBucket = [&](int64_t from) {
+        for (int64_t b = from; b < from + window; b++) {
+            if (!binEmpty(b)) return b;
+        }
+        return *std::min_element(farMin.begin(), farMin.end());
+    };
+    // Moves far entries that now fall inside [index, index + window) into the
+    // bins and drops the ones whose distance has since been lowered
+    auto rebinFar = [&](int64_t index) {
+        #pragma omp parallel for schedule(static, 1)
+        for (int t = 0; t < maxThreads; t++) {
+            size_t kept = 0;
+            farMin[t] = none;
+            for (const auto& p : far[t]) {
+                if (distance[p.second] / delta != p.first) continue;
+                if (p.first < index + window) {
+                    bins[t][p.first % window].push_back(p.second);
+                } else {
+                    far[t][kept++] = p;
+                    farMin[t] = std::min(farMin[t], p.first);
+                }
+            }
+            far[t].resize(kept);
+        }
+    };
+    // Relaxes the light (or heavy) arcs of v from distance dv into thread
+    // tid's bins while bucket index (in bin slot) is being settled
+    auto relaxArcs = [&](V v, int64_t dv, bool light, int tid, int64_t index, int64_t slot) {
+        auto nbrs = g.neighbors(v);
+        const auto* w = g.weights(v);
+        int64_t relaxed = 0;
+        for (size_t k = 0; k < nbrs.size(); k++) {
+            if ((w[k] <= delta) != light) continue;
+            V u = nbrs.begin()[k];
+            int64_t nd = dv + w[k];
+            relaxed++;
+            if (!atomicMin(distance[u], nd)) continue;
+            int64_t b = nd / delta;
+            if (b < index + window) {
+                int64_t s = slot + (b - index); // b % window without the division
+                bins[tid][s < window ? s : s - window].push_back(u);
+            } else {
+                far[tid].emplace_back(b, u);
+                farMin[tid] = std::min(farMin[tid], b);
+            }
+        }
+        return relaxed;
+    };
+
+    int64_t relaxations = 0;
+    for (int64_t index = 0; (index = nextBucket(index)) != none;) {
+        // Every far entry stays at least a window ahead of the current bucket
+        if (*std::min_element(farMin.begin(), farMin.end()) < index + window) {
+            rebinFar(index);
+            if (binEmpty(index)) continue;
+        }
+        const int64_t slot = index % window;
+        result.buckets++;
+
+        // Light rounds until the bucket stays empty
+        for (;;) {
+            gather(current, [&](int t) -> std::vector<V>& { return bins[t][slot]; });
+            if (current.empty()) break;
+            result.phases++;
+            #pragma omp parallel reduction(+:relaxations)
+            {
+                const int tid = omp_get_thread_num();
+                std::vector<V>& localSettled = settledBuffers[tid];
+
+                #pragma omp for schedule(dynamic, 64)
+                for (int64_t i = 0; i < (int64_t)current.size(); i++) {
+                    V v = current[i];
+                    int64_t dv = atomicLoad(distance[v]);
+                    if (dv / delta != index) continue;
+                    if (!settled.testAndSet(v)) localSettled.push_back(v);
+                    relaxations += relaxArcs(v, dv, true, tid, index, slot);
+                }
+            }
+        }
+
+        // Heavy arcs from the now final distances of the bucket
+        gather(settledList, [&](int t) -> std::vector<V>& { return settledBuffers[t]; });
+        #pragma omp parallel reduction(+:relaxations)
+        {
+            const int tid = omp_get_thread_num();
+            #pragma omp for schedule(dynamic, 64)
+            for (int64_t i = 0; i < (int64_t)settledList.size(); i++) {
+                V v = settledList[i];
+                relaxations += relaxArcs(v, distance[v], false, tid, index, slot);
+            }
+        }
+    }
+    result.relaxations = relaxations;
+
+    int64_t reached = 0;
+    #pragma omp parallel for schedule(static) reduction(+:reached)
+    for (int64_t v = 0; v < (int64_t)n; v++) reached += distance[v] != SSSPResult::unreachable;
+    result.reached = reached;
+    return result;
+}
+
+// Checks that distance is a shortest-path labelling from source on an
+// undirected graph: no arc can lower a distance, and every reached vertex but
+// the source has a tight incoming arc (so its distance is realised by a path)
+template <typename Graph>
+bool validateSSSP(const Graph& g, typename Graph::vertex_type source, const std::vector<int64_t>& distance) {
+    using V = typename Graph::vertex_type;
+    const V n = g.numVertices();
+    if ((V)distance.size() != n || distance[source] != 0) return false;
+    bool ok = true;
+
+    #pragma omp parallel for schedule(dynamic, 1024) reduction(&&:ok)
+    for (int64_t v = 0; v < (int64_t)n; v++) {
+        if (distance[v] == SSSPResult::unreachable) continue;
+        bool tight = v == (int64_t)source;
+        auto nbrs = g.neighbors((V)v);
+        const auto* w = g.weights((V)v);
+        for (size_t k = 0; k < nbrs.size(); k++) {
+            int64_t du = distance[nbrs.begin()[k]];
+            if (du > distance[v] + w[k]) ok = false;
+            if (du != SSSPResult::unreachable && du + w[k] == distance[v]) tight = true;
+        }
+        if (!tight) ok = false;
+    }
+    return ok;
+}
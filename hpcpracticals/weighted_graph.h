@@ -0,0 +1,153 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <omp.h>
+#include "csr_graph.h"
+#include "parallel_utils.h"
+
+// CSRGraph plus one weight per stored arc. weights(v)[i] is the weight of the
+// arc to neighbors(v)[i], so relaxations walk two parallel flat arrays. The
+// unweighted structure stays a plain CSRGraph, and every engine written for
+// CSRGraph (BFS, DFS, components) also runs on structure() or on this class.
+// Weights must be non-negative; integral types keep the atomic distance
+// updates of the shortest-path engines to single compare-and-swaps.
+template <typename VertexT = int32_t, typename WeightT = int32_t, typename OffsetT = int64_t>
+class WeightedCSRGraph {
+public:
+    using vertex_type = VertexT;
+    using weight_type = WeightT;
+    using offset_type = OffsetT;
+    using Edge = std::pair<VertexT, VertexT>;
+    using Structure = CSRGraph<VertexT, OffsetT>;
+    using NeighborRange = typename Structure::NeighborRange;
+
+    WeightedCSRGraph() = default;
+
+    WeightedCSRGraph(Structure structure, std::vector<WeightT> weights)
+        : structure_(std::move(structure)), weights_(std::move(weights)) {
+        if ((OffsetT)weights_.size() != structure_.numArcs()) {
+            throw std::invalid_argument("WeightedCSRGraph: one weight per arc expected");
+        }
+        maxWeight_ = 0;
+        #pragma omp parallel for schedule(static) reduction(max:maxWeight_)
+        for (int64_t i = 0; i < (int64_t)weights_.size(); i++) maxWeight_ = std::max(maxWeight_, weights_[i]);
+    }
+
+    // Same count / prefix sum / scatter as CSRGraph::fromEdgesParallel, with the
+    // weight of edges[i] in weights[i] scattered next to its endpoint. With
+    // removeDuplicates, parallel edges collapse to the lightest one.
+    static WeightedCSRGraph fromEdgesParallel(VertexT numVertices, const std::vector<Edge>& edges,
+                                              const std::vector<WeightT>& weights,
+                                              const CSRBuildOptions& options = CSRBuildOptions()) {
+        const int64_t m = edges.size();
+        if ((int64_t)weights.size() != m) throw std::invalid_argument("WeightedCSRGraph: one weight per edge expected");
+        const bool skipLoops = options.removeSelfLoops;
+        std::vector<OffsetT> offsets(static_cast<size_t>(numVertices) + 1, 0);
+        bool badEdge = false, badWeight = false;
+
+        #pragma omp parallel for schedule(static) reduction(||:badEdge, badWeight)
+        for (int64_t i = 0; i < m; i++) {
+            VertexT u = edges[i].first, v = edges[i].second;
+            if (u < 0 || u >= numVertices || v < 0 || v >= numVertices) {
+                badEdge = true;
+                continue;
+            }
+            if (weights[i] < 0) badWeight = true;
+            if (skipLoops && u == v) continue;
+            __atomic_fetch_add(&offsets[u], 1, __ATOMIC_RELAXED);
+            if (options.undirected) __atomic_fetch_add(&offsets[v], 1, __ATOMIC_RELAXED);
+        }
+        if (badEdge) throw std::out_of_range("WeightedCSRGraph: edge endpoint out of range");
+        if (badWeight) throw std::invalid_argument("WeightedCSRGraph: negative edge weight");
+        offsets[numVertices] = parallelExclusiveScan(offsets.data(), numVertices);
+
+        std::vector<VertexT> adjacency(static_cast<size_t>(offsets[numVertices]));
+        std::vector<WeightT> arcWeights(adjacency.size());
+        std::vector<OffsetT> cursor(offsets.begin(), offsets.end() - 1);
+        #pragma omp parallel for schedule(static)
+        for (int64_t i = 0; i < m; i++) {
+            VertexT u = edges[i].first, v = edges[i].second;
+            if (skipLoops && u == v) continue;
+            OffsetT pos = __atomic_fetch_add(&cursor[u], 1, __ATOMIC_RELAXED);
+            adjacency[pos] = v;
+            arcWeights[pos] = weights[i];
+            if (options.undirected) {
+                pos = __atomic_fetch_add(&cursor[v], 1, __ATOMIC_RELAXED);
+                adjacency[pos] = u;
+                arcWeights[pos] = weights[i];
+            }
+        }
+        std::vector<OffsetT>().swap(cursor);
+
+        if (!options.sortNeighbors && !options.removeDuplicates) {
+            return WeightedCSRGraph(Structure(std::move(offsets), std::move(adjacency)), std::move(arcWeights));
+        }
+
+        // Sort each list by (neighbour, weight) through a per-thread pair buffer
+        std::vector<OffsetT> kept(options.removeDuplicates ? static_cast<size_t>(numVertices) + 1 : 0, 0);
+        std::vector<std::vector<std::pair<VertexT, WeightT>>> scratch(omp_get_max_threads());
+        #pragma omp parallel for schedule(dynamic, 256)
+        for (int64_t v = 0; v < (int64_t)numVertices; v++) {
+            std::vector<std::pair<VertexT, WeightT>>& buf = scratch[omp_get_thread_num()];
+            buf.clear();
+            for (OffsetT i = offsets[v]; i < offsets[v + 1]; i++) buf.emplace_back(adjacency[i], arcWeights[i]);
+            std::sort(buf.begin(), buf.end());
+            if (options.removeDuplicates) {
+                auto last = std::unique(buf.begin(), buf.end(), [](const std::pair<VertexT, WeightT>& a,
+                                                                  const std::pair<VertexT, WeightT>& b) {
+                    return a.first == b.first;
+                });
+                buf.erase(last, buf.end());
+                kept[v] = buf.size();
+            }
+            for (size_t i = 0; i < buf.size(); i++) {
+                adjacency[offsets[v] + i] = buf[i].first;
+                arcWeights[offsets[v] + i] = buf[i].second;
+            }
+        }
+        if (!options.removeDuplicates) {
+            return WeightedCSRGraph(Structure(std::move(offsets), std::move(adjacency)), std::move(arcWeights));
+        }
+
+        kept[numVertices] = parallelExclusiveScan(kept.data(), numVertices);
+        std::vector<VertexT> compact(static_cast<size_t>(kept[numVertices]));
+        std::vector<WeightT> compactWeights(compact.size());
+        #pragma omp parallel for schedule(dynamic, 256)
+        for (int64_t v = 0; v < (int64_t)numVertices; v++) {
+            const OffsetT count = kept[v + 1] - kept[v];
+            std::copy(adjacency.begin() + offsets[v], adjacency.begin() + offsets[v] + count, compact.begin() + kept[v]);
+            std::copy(arcWeights.begin() + offsets[v], arcWeights.begin() + offsets[v] + count,
+                      compactWeights.begin() + kept[v]);
+        }
+        return WeightedCSRGraph(Structure(std::move(kept), std::move(compact)), std::move(compactWeights));
+    }
+
+    VertexT numVertices() const { return structure_.numVertices(); }
+
+    OffsetT numArcs() const { return structure_.numArcs(); }
+
+    OffsetT degree(VertexT v) const { return structure_.degree(v); }
+
+    NeighborRange neighbors(VertexT v) const { return structure_.neighbors(v); }
+
+    // Weights of the arcs in neighbors(v), in the same order
+    const WeightT* weights(VertexT v) const { return weights_.data() + structure_.offsets()[v]; }
+
+    WeightT maxWeight() const { return maxWeight_; }
+
+    const Structure& structure() const { return structure_; }
+
+    size_t memoryBytes() const { return structure_.memoryBytes() + weights_.size() * sizeof(WeightT); }
+
+private:
+    Structure structure_;
+    std::vector<WeightT> weights_;
+    WeightT maxWeight_ = 0;
+};
+
+using WeightedCSRGraph32 = WeightedCSRGraph<int32_t, int32_t, int64_t>;